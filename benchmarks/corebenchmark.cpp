@@ -0,0 +1,430 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "choices.h"
+#include "direnumerator.h"
+#include "fileuris.h"
+#include "filters.h"
+#include "utils.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDBusArgument>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+// Counts heap allocations of the whole process so each benchmark can report
+// allocations per operation next to the time QBENCHMARK measures.
+static std::atomic<quint64> s_allocations{0};
+
+static void *countedAlloc(std::size_t size)
+{
+    ++s_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+static void *countedAlignedAlloc(std::size_t size, std::size_t alignment)
+{
+    ++s_allocations;
+    void *p = nullptr;
+    if (posix_memalign(&p, qMax(alignment, sizeof(void *)), size ? size : 1) != 0) {
+        return nullptr;
+    }
+    return p;
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *p = countedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *p = countedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void *p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAlignedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAlignedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+// malloc() and posix_memalign() memory is released with free() either way
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+
+namespace LXQt
+{
+    class CoreBenchmark : public QObject
+    {
+        Q_OBJECT
+    private Q_SLOTS:
+        void initTestCase();
+
+        void extractFilters_data();
+        void extractFilters();
+        void nameFiltersForMimeType_data();
+        void nameFiltersForMimeType();
+        void marshalFilters_data();
+        void marshalFilters();
+        void marshalChoices_data();
+        void marshalChoices();
+        void convertGtkMnemonic_data();
+        void convertGtkMnemonic();
+        void evaluateChoices_data();
+        void evaluateChoices();
+        void listDirectories_data();
+        void listDirectories();
+        void fileUris_data();
+        void fileUris();
+
+    private:
+        static void addSizes();
+        static FilterListList makeFilters(int count, bool mimeTypes);
+        static OptionList makeOptions(int count);
+
+        template<typename Op>
+        static void reportAllocations(Op op)
+        {
+            const quint64 before = s_allocations.load();
+            op();
+            qInfo("allocations/op: %llu", static_cast<unsigned long long>(s_allocations.load() - before));
+        }
+    };
+
+    void CoreBenchmark::initTestCase()
+    {
+        registerFilterMetaTypes();
+        registerChoiceMetaTypes();
+    }
+
+    void CoreBenchmark::addSizes()
+    {
+        QTest::addColumn<int>("count");
+        for (int count : {1, 10, 100, 1000, 10000}) {
+            QTest::addRow("%d", count) << count;
+        }
+    }
+
+    FilterListList CoreBenchmark::makeFilters(int count, bool mimeTypes)
+    {
+        static const char *const mimes[] = {"image/png", "image/jpeg", "text/plain", "application/pdf", "audio/mpeg"};
+        FilterListList filterListList;
+        filterListList.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            FilterList filterList;
+            filterList.userVisibleName = QStringLiteral("Filter %1").arg(i);
+            filterList.filters.append({0, QStringLiteral("*.ext%1").arg(i)});
+            if (mimeTypes) {
+                filterList.filters.append({1, QString::fromLatin1(mimes[i % 5])});
+            }
+            filterListList.append(filterList);
+        }
+        return filterListList;
+    }
+
+    OptionList CoreBenchmark::makeOptions(int count)
+    {
+        OptionList optionList;
+        optionList.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            Option option;
+            option.id = QStringLiteral("option%1").arg(i);
+            option.label = QStringLiteral("Option %1").arg(i);
+            if (i % 2 == 0) {
+                for (int j = 0; j < 4; ++j) {
+                    option.choices.append({QStringLiteral("value%1").arg(j), QStringLiteral("Value %1").arg(j)});
+                }
+                option.initialChoiceId = QStringLiteral("value1");
+            } else {
+                option.initialChoiceId = QStringLiteral("true");
+            }
+            optionList.append(option);
+        }
+        return optionList;
+    }
+
+    void CoreBenchmark::extractFilters_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::extractFilters()
+    {
+        QFETCH(int, count);
+        const FilterListList filterListList = makeFilters(count, true);
+        QVariantMap options;
+        options.insert(QStringLiteral("filters"), QVariant::fromValue(filterListList));
+        options.insert(QStringLiteral("current_filter"), QVariant::fromValue(filterListList.constLast()));
+
+        const auto op = [&options] {
+            QStringList nameFilters;
+            QMap<QString, FilterList> allFilters;
+            QString selectedNameFilter;
+            ExtractFilters(options, nameFilters, allFilters, selectedNameFilter);
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::nameFiltersForMimeType_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::nameFiltersForMimeType()
+    {
+        QFETCH(int, count);
+        static const QString mimes[] = {QStringLiteral("image/png"), QStringLiteral("text/plain"), QStringLiteral("application/pdf")};
+        const auto op = [count] {
+            for (int i = 0; i < count; ++i) {
+                NameFiltersForMimeType(mimes[i % 3]);
+            }
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::marshalFilters_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::marshalFilters()
+    {
+        QFETCH(int, count);
+        const FilterListList filterListList = makeFilters(count, true);
+        const auto op = [&filterListList] {
+            QDBusArgument arg;
+            arg << filterListList;
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::marshalChoices_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::marshalChoices()
+    {
+        QFETCH(int, count);
+        const OptionList optionList = makeOptions(count);
+        const auto op = [&optionList] {
+            QDBusArgument arg;
+            arg << optionList;
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::convertGtkMnemonic_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::convertGtkMnemonic()
+    {
+        QFETCH(int, count);
+        QString label;
+        for (int i = 0; i < count; ++i) {
+            label += QStringLiteral("Save & _Close ");
+        }
+        const auto op = [&label] {
+            QString copy = label;
+            Utils::convertGtkMnemonic(copy);
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::evaluateChoices_data()
+    {
+        addSizes();
+    }
+
+    void CoreBenchmark::evaluateChoices()
+    {
+        QFETCH(int, count);
+        QMap<QString, QCheckBox *> checkboxes;
+        QMap<QString, QComboBox *> comboboxes;
+        const std::unique_ptr<QWidget> controls{CreateChoiceControls(makeOptions(count), checkboxes, comboboxes)};
+
+        const auto op = [&checkboxes, &comboboxes] {
+            EvaluateSelectedChoices(checkboxes, comboboxes);
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::listDirectories_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::addColumn<bool>("enumerator");
+        for (int count : {10, 1000, 10000}) {
+            QTest::addRow("QDir %d", count) << count << false;
+            QTest::addRow("DirEnumerator %d", count) << count << true;
+        }
+    }
+
+    void CoreBenchmark::listDirectories()
+    {
+        QFETCH(int, count);
+        QFETCH(bool, enumerator);
+
+        // one folder per 100 files, like a typical photo archive or build tree
+        QTemporaryDir tree;
+        QVERIFY(tree.isValid());
+        QDir root{tree.path()};
+        for (int i = 0; i < count; ++i) {
+            QFile file{root.filePath(QStringLiteral("file%1.jpg").arg(i))};
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            if (i % 100 == 0) {
+                QVERIFY(root.mkdir(QStringLiteral("folder%1").arg(i)));
+            }
+        }
+
+        const QByteArray path = QFile::encodeName(tree.path());
+        const auto op = [&root, &path, enumerator] {
+            if (enumerator) {
+                QList<QByteArray> names;
+                DirEnumerator::list(path, DirEnumerator::DirectoriesOnly, names);
+            } else {
+                root.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+            }
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+
+    void CoreBenchmark::fileUris_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::addColumn<bool>("encoder");
+        for (int count : {1, 100, 10000, 50000}) {
+            QTest::addRow("toDisplayString %d", count) << count << false;
+            QTest::addRow("FileUris %d", count) << count << true;
+        }
+    }
+
+    void CoreBenchmark::fileUris()
+    {
+        QFETCH(int, count);
+        QFETCH(bool, encoder);
+        QList<QUrl> urls;
+        urls.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            urls.append(QUrl::fromLocalFile(QStringLiteral("/srv/datasets/run %1/sample_%2 (copy).dat").arg(i / 1000).arg(i)));
+        }
+
+        const auto op = [&urls, encoder] {
+            if (encoder) {
+                FileUris::fromUrls(urls);
+            } else {
+                // how the results were built before
+                QStringList files;
+                for (const auto &url : urls) {
+                    files << url.toDisplayString();
+                }
+            }
+        };
+        QBENCHMARK {
+            op();
+        }
+        reportAllocations(op);
+    }
+}
+
+QTEST_MAIN(LXQt::CoreBenchmark)
+
+#include "corebenchmark.moc"
@@ -26,12 +26,17 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "access.h"
+#include "accessbatch.h"
 #include "choices.h"
+#include "parentwindow.h"
+#include "portalsettings.h"
+#include "portaltrace.h"
 #include "utils.h"
 
 #include <QCheckBox>
 #include <QComboBox>
 #include <QDBusArgument>
+#include <QDBusMessage>
 #include <QDBusObjectPath>
 #include <QDialog>
 #include <QDialogButtonBox>
@@ -60,10 +65,9 @@ namespace LXQt
             const QString &subtitle,
             const QString &body,
             const QVariantMap &options,
+            const QDBusMessage &message,
             QVariantMap &results)
     {
-        Q_UNUSED(app_id);
-
         qCDebug(XdgDesktopPortalLxqtAccess) << "AccessDialog called with parameters:";
         qCDebug(XdgDesktopPortalLxqtAccess) << "    handle: " << handle.path();
         qCDebug(XdgDesktopPortalLxqtAccess) << "    parent_window: " << parent_window;
@@ -72,6 +76,12 @@ namespace LXQt
         qCDebug(XdgDesktopPortalLxqtAccess) << "    body: " << body;
         qCDebug(XdgDesktopPortalLxqtAccess) << "    options: " << options;
 
+        if (auto recorder = TraceRecorder::instance()) {
+            recorder->record(QStringLiteral("AccessDialog"), {app_id, parent_window, title, subtitle, body}, options);
+        }
+
+        ParentWindow::prefetch(parent_window);
+
         bool modalDialog = true;
         if (options.contains(QStringLiteral("modal"))) {
             modalDialog = options.value(QStringLiteral("modal")).toBool();
@@ -89,6 +99,18 @@ namespace LXQt
             Utils::convertGtkMnemonic(denyLabel);
         }
 
+        // prompts with choices need their controls, they keep a dialog of their own
+        const int batchWindow = PortalSettings::instance().accessBatchWindow();
+        if (batchWindow > 0 && !options.contains(QStringLiteral("choices"))) {
+            if (m_batch == nullptr) {
+                m_batch = new AccessBatch{batchWindow, this};
+            }
+            message.setDelayedReply(true);
+            m_batch->enqueue({message, parent_window, title, subtitle, body,
+                    options.value(QStringLiteral("icon")).toString(), grantLabel, denyLabel});
+            return 0;
+        }
+
         // for handling of options - choices
         QMap<QString, QCheckBox *> checkboxes;
         QMap<QString, QComboBox *> comboboxes;
@@ -105,7 +127,6 @@ namespace LXQt
         QDialog dialog;
         dialog.setWindowTitle(title);
         dialog.setWindowModality(modalDialog ? Qt::ApplicationModal : Qt::NonModal);
-        Utils::setParentWindow(&dialog, parent_window);
 
         QVBoxLayout *layout = new QVBoxLayout(&dialog);
 
@@ -159,9 +180,13 @@ namespace LXQt
         QObject::connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
         layout->addWidget(buttonBox);
 
+        // the parent was validated while the dialog was built
+        Utils::setParentWindow(&dialog, parent_window);
+
         QEventLoop loop;
         QObject::connect(&dialog, &QDialog::finished, &loop, &QEventLoop::quit);
         dialog.open();
+        Utils::scheduleAutoResponse(&dialog);
         loop.exec();
 
         if (dialog.result() == QDialog::Accepted) {
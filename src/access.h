@@ -29,10 +29,13 @@
 
 #include <QDBusAbstractAdaptor>
 
+class QDBusMessage;
 class QDBusObjectPath;
 
 namespace LXQt
 {
+    class AccessBatch;
+
     class AccessPortal : public QDBusAbstractAdaptor
     {
         Q_OBJECT
@@ -48,6 +51,10 @@ namespace LXQt
                 const QString &subtitle,
                 const QString &body,
                 const QVariantMap &options,
+                const QDBusMessage &message,
                 QVariantMap &results);
+
+    private:
+        AccessBatch *m_batch = nullptr;
     };
 }
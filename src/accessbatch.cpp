@@ -0,0 +1,431 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#include "accessbatch.h"
+#include "utils.h"
+
+#include <QAbstractListModel>
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QHash>
+#include <QIcon>
+#include <QLabel>
+#include <QListView>
+#include <QLoggingCategory>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPushButton>
+#include <QStyledItemDelegate>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <functional>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtAccessBatch, "xdp-lxqt-access-batch")
+
+    class AccessPromptModel : public QAbstractListModel
+    {
+    public:
+        using QAbstractListModel::QAbstractListModel;
+
+        int rowCount(const QModelIndex &parent = QModelIndex()) const override
+        {
+            return parent.isValid() ? 0 : m_prompts.size();
+        }
+
+        QVariant data(const QModelIndex &index, int role) const override
+        {
+            if (!index.isValid() || index.row() >= m_prompts.size()) {
+                return {};
+            }
+            const AccessBatch::Prompt &prompt = m_prompts.at(index.row());
+            if (role == Qt::DisplayRole || role == Qt::AccessibleTextRole) {
+                return prompt.subtitle.isEmpty() ? prompt.title : prompt.subtitle;
+            }
+            if (role == Qt::ToolTipRole || role == Qt::AccessibleDescriptionRole) {
+                return prompt.body;
+            }
+            return {};
+        }
+
+        const AccessBatch::Prompt &prompt(int row) const
+        {
+            return m_prompts.at(row);
+        }
+
+        const QList<AccessBatch::Prompt> &prompts() const
+        {
+            return m_prompts;
+        }
+
+        void append(const QList<AccessBatch::Prompt> &prompts)
+        {
+            beginInsertRows(QModelIndex(), m_prompts.size(), m_prompts.size() + prompts.size() - 1);
+            m_prompts.append(prompts);
+            endInsertRows();
+        }
+
+        AccessBatch::Prompt take(int row)
+        {
+            beginRemoveRows(QModelIndex(), row, row);
+            AccessBatch::Prompt prompt = m_prompts.takeAt(row);
+            endRemoveRows();
+            return prompt;
+        }
+
+    private:
+        QList<AccessBatch::Prompt> m_prompts;
+    };
+
+    // Paints a prompt with its own grant and deny buttons; a click on one of them decides
+    // the row.
+    class AccessPromptDelegate : public QStyledItemDelegate
+    {
+    public:
+        using Decide = std::function<void(int row, bool granted)>;
+
+        AccessPromptDelegate(const AccessPromptModel *model, QListView *view, const Decide &decide)
+            : QStyledItemDelegate(view)
+            , m_model{model}
+            , m_view{view}
+            , m_decide{decide}
+        {
+        }
+
+        void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+        {
+            const AccessBatch::Prompt &prompt = m_model->prompt(index.row());
+            const Layout layout = rowLayout(option, prompt);
+            QStyle *style = m_view->style();
+
+            QStyleOptionViewItem background = option;
+            initStyleOption(&background, index);
+            background.text.clear();
+            style->drawPrimitive(QStyle::PE_PanelItemViewItem, &background, painter, m_view);
+
+            painter->save();
+            const QIcon icon = this->icon(prompt.iconName);
+            if (!icon.isNull()) {
+                icon.paint(painter, layout.icon);
+            }
+            const QPalette::ColorRole textRole = option.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text;
+            painter->setPen(option.palette.color(textRole));
+            painter->setFont(titleFont(option.font));
+            painter->drawText(layout.title, Qt::TextWordWrap, prompt.title);
+            painter->setFont(subtitleFont(option.font));
+            painter->drawText(layout.subtitle, Qt::TextWordWrap, prompt.subtitle);
+            painter->setFont(option.font);
+            painter->drawText(layout.body, Qt::TextWordWrap, prompt.body);
+            painter->restore();
+
+            drawButton(painter, option, layout.grant, prompt.grantLabel);
+            drawButton(painter, option, layout.deny, prompt.denyLabel);
+        }
+
+        QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override
+        {
+            QStyleOptionViewItem sized = option;
+            sized.rect = QRect{0, 0, m_view->viewport()->width(), 0};
+            const Layout layout = rowLayout(sized, m_model->prompt(index.row()));
+            return {sized.rect.width(), layout.height};
+        }
+
+        bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index) override
+        {
+            if (event->type() != QEvent::MouseButtonRelease && event->type() != QEvent::MouseButtonPress) {
+                return QStyledItemDelegate::editorEvent(event, model, option, index);
+            }
+            auto mouseEvent = static_cast<QMouseEvent *>(event);
+            const Layout layout = rowLayout(option, m_model->prompt(index.row()));
+            const QPoint pos = mouseEvent->position().toPoint();
+            const bool onGrant = layout.grant.contains(pos);
+            if (!onGrant && !layout.deny.contains(pos)) {
+                return QStyledItemDelegate::editorEvent(event, model, option, index);
+            }
+            // a press on a button doesn't change the selection
+            if (event->type() == QEvent::MouseButtonRelease && mouseEvent->button() == Qt::LeftButton) {
+                m_decide(index.row(), onGrant);
+            }
+            return true;
+        }
+
+    private:
+        static constexpr int Margin = 8;
+        static constexpr int IconSize = 32;
+
+        struct Layout {
+            QRect icon;
+            QRect title;
+            QRect subtitle;
+            QRect body;
+            QRect grant;
+            QRect deny;
+            int height;
+        };
+
+        static QFont titleFont(const QFont &font)
+        {
+            QFont title = font;
+            title.setPointSizeF(font.pointSizeF() * 0.9);
+            return title;
+        }
+
+        static QFont subtitleFont(const QFont &font)
+        {
+            QFont subtitle = font;
+            subtitle.setBold(true);
+            return subtitle;
+        }
+
+        static int textHeight(const QFont &font, int width, const QString &text)
+        {
+            if (text.isEmpty()) {
+                return 0;
+            }
+            return QFontMetrics{font}.boundingRect(QRect{0, 0, width, 0}, Qt::TextWordWrap, text).height();
+        }
+
+        QSize buttonSize(const QStyleOptionViewItem &option, const QString &label) const
+        {
+            QStyleOptionButton button;
+            button.initFrom(m_view);
+            button.text = label;
+            const QSize textSize = option.fontMetrics.size(Qt::TextShowMnemonic, label);
+            return m_view->style()->sizeFromContents(QStyle::CT_PushButton, &button, textSize, m_view);
+        }
+
+        // geometry of a row for the width of option.rect, shared by painting and hit testing
+        Layout rowLayout(const QStyleOptionViewItem &option, const AccessBatch::Prompt &prompt) const
+        {
+            Layout layout;
+            const QRect rect = option.rect;
+            const int textLeft = rect.left() + Margin + IconSize + Margin;
+            const int textWidth = qMax(IconSize, rect.right() - Margin - textLeft);
+
+            int y = rect.top() + Margin;
+            layout.icon = QRect{rect.left() + Margin, y, IconSize, IconSize};
+            layout.title = QRect{textLeft, y, textWidth, textHeight(titleFont(option.font), textWidth, prompt.title)};
+            y = layout.title.bottom() + 1;
+            layout.subtitle = QRect{textLeft, y, textWidth, textHeight(subtitleFont(option.font), textWidth, prompt.subtitle)};
+            y = layout.subtitle.bottom() + 1;
+            layout.body = QRect{textLeft, y, textWidth, textHeight(option.font, textWidth, prompt.body)};
+            y = qMax(layout.body.bottom() + 1, layout.icon.bottom() + 1) + Margin / 2;
+
+            const QSize denySize = buttonSize(option, prompt.denyLabel);
+            const QSize grantSize = buttonSize(option, prompt.grantLabel);
+            layout.deny = QRect{QPoint{rect.right() - Margin - denySize.width(), y}, denySize};
+            layout.grant = QRect{QPoint{layout.deny.left() - Margin / 2 - grantSize.width(), y}, grantSize};
+            layout.height = y + qMax(grantSize.height(), denySize.height()) + Margin - rect.top();
+            return layout;
+        }
+
+        void drawButton(QPainter *painter, const QStyleOptionViewItem &option, const QRect &rect, const QString &label) const
+        {
+            QStyleOptionButton button;
+            button.initFrom(m_view);
+            button.rect = rect;
+            button.text = label;
+            button.state = QStyle::State_Enabled | QStyle::State_Raised;
+            if ((option.state & QStyle::State_MouseOver) && rect.contains(m_view->viewport()->mapFromGlobal(QCursor::pos()))) {
+                button.state |= QStyle::State_MouseOver;
+            }
+            m_view->style()->drawControl(QStyle::CE_PushButton, &button, painter, m_view);
+        }
+
+        // themed icons are looked up once per name, not per painted row
+        QIcon icon(const QString &name) const
+        {
+            if (name.isEmpty()) {
+                return {};
+            }
+            auto it = m_icons.find(name);
+            if (it == m_icons.end()) {
+                it = m_icons.insert(name, QIcon::fromTheme(name));
+            }
+            return it.value();
+        }
+
+        const AccessPromptModel *m_model;
+        QListView *m_view;
+        Decide m_decide;
+        mutable QHash<QString, QIcon> m_icons;
+    };
+
+    class AccessPromptDialog : public QDialog
+    {
+        Q_OBJECT
+    public:
+        AccessPromptDialog()
+        {
+            setAttribute(Qt::WA_DeleteOnClose);
+            setWindowTitle(tr("Access Requests"));
+            resize(520, 420);
+
+            auto layout = new QVBoxLayout{this};
+            m_header = new QLabel{this};
+            layout->addWidget(m_header);
+
+            m_view = new QListView{this};
+            m_view->setModel(&m_model);
+            m_view->setItemDelegate(new AccessPromptDelegate{&m_model, m_view, [this](int row, bool granted) {
+                decide({row}, granted);
+            }});
+            m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+            m_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+            m_view->setResizeMode(QListView::Adjust);
+            // lay out the rows in view first, the rest in the background
+            m_view->setLayoutMode(QListView::Batched);
+            m_view->setBatchSize(32);
+            m_view->setMouseTracking(true);
+            layout->addWidget(m_view);
+
+            auto buttonBox = new QDialogButtonBox{this};
+            QPushButton *grantButton = buttonBox->addButton(tr("Grant Selected"), QDialogButtonBox::ActionRole);
+            QPushButton *denyButton = buttonBox->addButton(tr("Deny Selected"), QDialogButtonBox::ActionRole);
+            buttonBox->addButton(QDialogButtonBox::Close);
+            grantButton->setAutoDefault(false);
+            denyButton->setAutoDefault(false);
+            connect(grantButton, &QPushButton::clicked, this, [this] {
+                decide(selectedRows(), true);
+            });
+            connect(denyButton, &QPushButton::clicked, this, [this] {
+                decide(selectedRows(), false);
+            });
+            connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+            layout->addWidget(buttonBox);
+        }
+
+        void append(const QList<AccessBatch::Prompt> &prompts)
+        {
+            m_model.append(prompts);
+            updateHeader();
+        }
+
+        const QList<AccessBatch::Prompt> &prompts() const
+        {
+            return m_model.prompts();
+        }
+
+        // Accepting grants, rejecting (Close, Escape, closing the window) denies the
+        // prompts still open, like the single dialog does when it is closed.
+        void done(int result) override
+        {
+            while (m_model.rowCount() > 0) {
+                AccessBatch::reply(m_model.take(m_model.rowCount() - 1), result == QDialog::Accepted);
+            }
+            QDialog::done(result);
+        }
+
+    private:
+        QList<int> selectedRows() const
+        {
+            QList<int> rows;
+            const QModelIndexList selected = m_view->selectionModel()->selectedIndexes();
+            for (const QModelIndex &index : selected) {
+                rows.append(index.row());
+            }
+            return rows;
+        }
+
+        void decide(QList<int> rows, bool granted)
+        {
+            // back to front, so the remaining rows keep their numbers
+            std::sort(rows.begin(), rows.end(), std::greater<int>());
+            for (int row : rows) {
+                AccessBatch::reply(m_model.take(row), granted);
+            }
+            if (m_model.rowCount() == 0) {
+                QDialog::done(granted ? QDialog::Accepted : QDialog::Rejected);
+                return;
+            }
+            updateHeader();
+        }
+
+        void updateHeader()
+        {
+            m_header->setText(tr("%n request(s) for access", nullptr, m_model.rowCount()));
+        }
+
+        AccessPromptModel m_model;
+        QLabel *m_header;
+        QListView *m_view;
+    };
+
+    AccessBatch::AccessBatch(int window, QObject *parent)
+        : QObject(parent)
+    {
+        m_timer.setSingleShot(true);
+        m_timer.setInterval(window);
+        connect(&m_timer, &QTimer::timeout, this, &AccessBatch::show);
+    }
+
+    void AccessBatch::enqueue(const Prompt &prompt)
+    {
+        if (m_dialog) {
+            m_dialog->append({prompt});
+            return;
+        }
+        m_queued.append(prompt);
+        if (!m_timer.isActive()) {
+            m_timer.start();
+        }
+    }
+
+    /*static*/ void AccessBatch::reply(const Prompt &prompt, bool granted)
+    {
+        const uint response = granted ? 0 : 1;
+        QDBusConnection::sessionBus().send(prompt.message.createReply(QVariantList{response, QVariantMap{}}));
+    }
+
+    void AccessBatch::show()
+    {
+        qCDebug(XdgDesktopPortalLxqtAccessBatch) << "Showing" << m_queued.size() << "access prompts";
+
+        m_dialog = new AccessPromptDialog;
+        m_dialog->append(m_queued);
+        m_queued.clear();
+
+        // The dialog serves several callers, so it is never application modal; it is
+        // only attached to a parent window all prompts of the batch share.
+        const QList<Prompt> &prompts = m_dialog->prompts();
+        const QString parentWindow = prompts.constFirst().parentWindow;
+        const bool sameParent = std::all_of(prompts.cbegin(), prompts.cend(), [&parentWindow](const Prompt &prompt) {
+            return prompt.parentWindow == parentWindow;
+        });
+        if (sameParent) {
+            Utils::setParentWindow(m_dialog, parentWindow);
+        }
+
+        m_dialog->open();
+        Utils::scheduleAutoResponse(m_dialog);
+    }
+}
+
+#include "accessbatch.moc"
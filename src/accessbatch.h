@@ -0,0 +1,75 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#pragma once
+
+#include <QDBusMessage>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+namespace LXQt
+{
+    class AccessPromptDialog;
+
+    // Batching mode of the Access portal ([Access] BatchWindow). AccessDialog calls arriving
+    // within the batch window are shown as rows of a single dialog, and calls arriving while
+    // it is open are appended to it. Each call is answered with a delayed reply as soon as
+    // its row is granted or denied, so the GUI thread doesn't run a nested event loop per
+    // prompt. The rows are painted by a delegate: a burst of prompts costs model rows, not
+    // widgets and layouts.
+    class AccessBatch : public QObject
+    {
+        Q_OBJECT
+    public:
+        struct Prompt {
+            QDBusMessage message;
+            QString parentWindow;
+            QString title;
+            QString subtitle;
+            QString body;
+            QString iconName;
+            QString grantLabel;
+            QString denyLabel;
+        };
+
+        AccessBatch(int window, QObject *parent);
+
+        // the caller has marked prompt.message for a delayed reply
+        void enqueue(const Prompt &prompt);
+
+        // sends the reply for a decided prompt
+        static void reply(const Prompt &prompt, bool granted);
+
+    private:
+        void show();
+
+        QTimer m_timer;
+        QList<Prompt> m_queued;
+        QPointer<AccessPromptDialog> m_dialog;
+    };
+}
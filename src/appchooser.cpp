@@ -0,0 +1,103 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "appchooser.h"
+#include "appchooserdialog.h"
+#include "desktopappindex.h"
+#include "utils.h"
+
+#include <QDBusObjectPath>
+#include <QEventLoop>
+#include <QLoggingCategory>
+#include <QUrl>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtAppChooser, "xdp-lxqt-app-chooser")
+
+    AppChooserPortal::AppChooserPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    uint AppChooserPortal::ChooseApplication(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QStringList &choices,
+            const QVariantMap &options,
+            QVariantMap &results)
+    {
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "ChooseApplication called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    choices: " << choices;
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    options: " << options;
+
+        bool modalDialog = true;
+        if (options.contains(QStringLiteral("modal"))) {
+            modalDialog = options.value(QStringLiteral("modal")).toBool();
+        }
+
+        QString location = options.value(QStringLiteral("filename")).toString();
+        if (location.isEmpty() && options.contains(QStringLiteral("uri"))) {
+            const QUrl uri{options.value(QStringLiteral("uri")).toString()};
+            location = uri.isLocalFile() ? uri.fileName() : uri.toDisplayString();
+        }
+
+        AppChooserDialog dialog{choices,
+            options.value(QStringLiteral("content_type")).toString(),
+            options.value(QStringLiteral("last_choice")).toString(),
+            location};
+        dialog.setWindowModality(modalDialog ? Qt::ApplicationModal : Qt::NonModal);
+        Utils::setParentWindow(&dialog, parent_window);
+        m_dialogs.insert(handle.path(), &dialog);
+
+        QEventLoop loop;
+        QObject::connect(&dialog, &QDialog::finished, &loop, &QEventLoop::quit);
+        dialog.open();
+        Utils::scheduleAutoResponse(&dialog);
+        loop.exec();
+        m_dialogs.remove(handle.path());
+
+        if (dialog.result() == QDialog::Accepted && !dialog.selectedChoice().isEmpty()) {
+            results.insert(QStringLiteral("choice"), dialog.selectedChoice());
+            return 0;
+        }
+
+        return 1;
+    }
+
+    void AppChooserPortal::UpdateChoices(const QDBusObjectPath &handle, const QStringList &choices)
+    {
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "UpdateChoices called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtAppChooser) << "    choices: " << choices;
+
+        if (auto dialog = m_dialogs.value(handle.path())) {
+            dialog->updateChoices(choices);
+        }
+    }
+}
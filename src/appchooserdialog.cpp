@@ -0,0 +1,163 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "appchooserdialog.h"
+#include "desktopappindex.h"
+
+#include <QDialogButtonBox>
+#include <QLabel>
+#include <QListWidget>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+namespace LXQt
+{
+    // marks items that came from the index rather than from the frontend's choices
+    static constexpr int OtherApplicationRole = Qt::UserRole + 1;
+
+    AppChooserDialog::AppChooserDialog(const QStringList &choices, const QString &contentType, const QString &lastChoice, const QString &location, QWidget *parent)
+        : QDialog(parent)
+        , m_contentType{contentType}
+        , m_list{new QListWidget{this}}
+    {
+        setWindowTitle(tr("Open With"));
+
+        auto layout = new QVBoxLayout{this};
+        auto heading = new QLabel{this};
+        heading->setTextFormat(Qt::PlainText);
+        heading->setWordWrap(true);
+        heading->setText(location.isEmpty() ? tr("Choose an application") : tr("Choose an application to open \"%1\"").arg(location));
+        layout->addWidget(heading);
+
+        m_list->setUniformItemSizes(true);
+        m_list->setIconSize(QSize(32, 32));
+        layout->addWidget(m_list);
+
+        auto buttonBox = new QDialogButtonBox{QDialogButtonBox::Open | QDialogButtonBox::Cancel, this};
+        connect(buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+        connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+        connect(m_list, &QListWidget::itemActivated, this, &QDialog::accept);
+        connect(m_list, &QListWidget::currentItemChanged, this, [buttonBox](QListWidgetItem *current) {
+            buttonBox->button(QDialogButtonBox::Open)->setEnabled(current != nullptr);
+        });
+        layout->addWidget(buttonBox);
+
+        for (const QString &id : choices) {
+            createItem(id, m_list->count());
+        }
+        m_choices = choices;
+        addOtherApplications();
+
+        const QString preferred = lastChoice.isEmpty() ? DesktopAppIndex::instance().defaultFor(contentType) : lastChoice;
+        m_list->setCurrentRow(0);
+        for (int row = 0; row < m_list->count(); ++row) {
+            if (m_list->item(row)->data(Qt::UserRole).toString() == preferred) {
+                m_list->setCurrentRow(row);
+                break;
+            }
+        }
+        buttonBox->button(QDialogButtonBox::Open)->setEnabled(m_list->currentItem() != nullptr);
+    }
+
+    QListWidgetItem *AppChooserDialog::createItem(const QString &id, int row)
+    {
+        auto item = new QListWidgetItem;
+        item->setData(Qt::UserRole, id);
+        if (auto application = DesktopAppIndex::instance().application(id)) {
+            item->setText(application->name);
+            item->setIcon(QIcon::fromTheme(application->icon, QIcon::fromTheme(QStringLiteral("application-x-executable"))));
+        } else {
+            item->setText(id);
+            item->setIcon(QIcon::fromTheme(QStringLiteral("application-x-executable")));
+        }
+        m_list->insertItem(row, item);
+        return item;
+    }
+
+    void AppChooserDialog::addOtherApplications()
+    {
+        if (m_contentType.isEmpty()) {
+            return;
+        }
+        for (const QString &id : DesktopAppIndex::instance().applicationsFor(m_contentType)) {
+            const auto application = DesktopAppIndex::instance().application(id);
+            if (m_choices.contains(id) || application == nullptr || application->noDisplay) {
+                continue;
+            }
+            auto item = createItem(id, m_list->count());
+            item->setData(OtherApplicationRole, true);
+        }
+    }
+
+    void AppChooserDialog::updateChoices(const QStringList &choices)
+    {
+        const QString current = selectedChoice();
+        m_list->setUpdatesEnabled(false);
+
+        // drop vanished choices, new choices go to the end of the frontend's block
+        int choiceRows = 0;
+        for (int row = 0; row < m_list->count();) {
+            QListWidgetItem *item = m_list->item(row);
+            if (item->data(OtherApplicationRole).toBool()) {
+                // choices that used to be listed as other applications move up
+                if (choices.contains(item->data(Qt::UserRole).toString())) {
+                    delete m_list->takeItem(row);
+                    continue;
+                }
+                ++row;
+                continue;
+            }
+            if (!choices.contains(item->data(Qt::UserRole).toString())) {
+                delete m_list->takeItem(row);
+                continue;
+            }
+            ++choiceRows;
+            ++row;
+        }
+        for (const QString &id : choices) {
+            if (!m_choices.contains(id)) {
+                createItem(id, choiceRows++);
+            }
+        }
+        m_choices = choices;
+
+        for (int row = 0; row < m_list->count(); ++row) {
+            if (m_list->item(row)->data(Qt::UserRole).toString() == current) {
+                m_list->setCurrentRow(row);
+                break;
+            }
+        }
+        if (m_list->currentItem() == nullptr) {
+            m_list->setCurrentRow(0);
+        }
+        m_list->setUpdatesEnabled(true);
+    }
+
+    QString AppChooserDialog::selectedChoice() const
+    {
+        const QListWidgetItem *item = m_list->currentItem();
+        return item ? item->data(Qt::UserRole).toString() : QString();
+    }
+}
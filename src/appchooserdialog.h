@@ -0,0 +1,63 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDialog>
+#include <QStringList>
+
+class QLabel;
+class QListWidget;
+class QListWidgetItem;
+
+namespace LXQt
+{
+    // The "Open With" list: the applications the frontend offers for the content type,
+    // followed by the other installed applications that handle it according to
+    // DesktopAppIndex.
+    class AppChooserDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        AppChooserDialog(const QStringList &choices, const QString &contentType, const QString &lastChoice, const QString &location, QWidget *parent = nullptr);
+
+        // adds new choices and removes vanished ones in place, keeping the selection and
+        // scroll position of a dialog that is already open
+        void updateChoices(const QStringList &choices);
+
+        // desktop file id of the chosen application
+        QString selectedChoice() const;
+
+    private:
+        QListWidgetItem *createItem(const QString &id, int row);
+        void addOtherApplications();
+
+    private:
+        QString m_contentType;
+        QStringList m_choices;
+        QListWidget *m_list;
+    };
+}
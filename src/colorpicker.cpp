@@ -0,0 +1,78 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "colorpicker.h"
+
+#include <QCursor>
+#include <QMouseEvent>
+#include <QPainter>
+
+namespace LXQt
+{
+    ColorPicker::ColorPicker(const QImage &capture, const QRect &rootGeometry, QWidget *parent)
+        : QDialog(parent, Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::X11BypassWindowManagerHint)
+        , m_capture{capture}
+    {
+        setGeometry(rootGeometry);
+        setCursor(Qt::CrossCursor);
+    }
+
+    void ColorPicker::paintEvent(QPaintEvent *event)
+    {
+        Q_UNUSED(event)
+        QPainter painter{this};
+        painter.drawImage(rect(), m_capture);
+    }
+
+    void ColorPicker::mousePressEvent(QMouseEvent *event)
+    {
+        if (event->button() != Qt::LeftButton) {
+            QDialog::mousePressEvent(event);
+            return;
+        }
+        pickAt(event->position().toPoint());
+        QDialog::accept();
+    }
+
+    void ColorPicker::accept()
+    {
+        if (!m_color.isValid()) {
+            pickAt(mapFromGlobal(QCursor::pos()));
+        }
+        QDialog::accept();
+    }
+
+    void ColorPicker::pickAt(const QPoint &position)
+    {
+        if (width() <= 0 || height() <= 0) {
+            return;
+        }
+        // the capture has device pixels, the widget logical ones
+        const QPoint pixel{position.x() * m_capture.width() / width(), position.y() * m_capture.height() / height()};
+        if (m_capture.rect().contains(pixel)) {
+            m_color = m_capture.pixelColor(pixel);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QColor>
+#include <QDialog>
+#include <QImage>
+
+namespace LXQt
+{
+    // Full-desktop overlay showing a frozen capture; a click picks the color under the
+    // pointer, Escape cancels. Accepting without a click picks at the pointer position.
+    class ColorPicker : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        // capture covers the root window, rootGeometry is where it lies in Qt coordinates
+        ColorPicker(const QImage &capture, const QRect &rootGeometry, QWidget *parent = nullptr);
+
+        QColor color() const { return m_color; }
+
+        void accept() override;
+
+    protected:
+        void paintEvent(QPaintEvent *event) override;
+        void mousePressEvent(QMouseEvent *event) override;
+
+    private:
+        void pickAt(const QPoint &position);
+
+    private:
+        QImage m_capture;
+        QColor m_color;
+    };
+}
@@ -0,0 +1,413 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "desktopappindex.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QLocale>
+#include <QLoggingCategory>
+#include <QMimeDatabase>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtApps, "xdp-lxqt-apps")
+
+    namespace
+    {
+        using KeyFile = QHash<QString, QHash<QString, QString>>;
+
+        // Desktop Entry Specification key files; QSettings would take ';' for a comment
+        // and split values at commas
+        KeyFile readKeyFile(const QString &path)
+        {
+            KeyFile groups;
+            QFile file{path};
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                return groups;
+            }
+            QHash<QString, QString> *group = nullptr;
+            while (!file.atEnd()) {
+                const QByteArray line = file.readLine().trimmed();
+                if (line.isEmpty() || line.startsWith('#')) {
+                    continue;
+                }
+                if (line.startsWith('[') && line.endsWith(']')) {
+                    group = &groups[QString::fromUtf8(line.mid(1, line.size() - 2))];
+                    continue;
+                }
+                const int separator = line.indexOf('=');
+                if (group && separator > 0) {
+                    group->insert(QString::fromUtf8(line.left(separator).trimmed()), QString::fromUtf8(line.mid(separator + 1).trimmed()));
+                }
+            }
+            return groups;
+        }
+
+        QStringList splitList(const QString &value, bool desktopIds)
+        {
+            QStringList items = value.split(QLatin1Char(';'), Qt::SkipEmptyParts);
+            if (desktopIds) {
+                for (QString &id : items) {
+                    if (id.endsWith(QLatin1String(".desktop"))) {
+                        id.chop(8);
+                    }
+                }
+            }
+            return items;
+        }
+
+        bool isTrue(const QString &value)
+        {
+            return value == QLatin1String("true");
+        }
+
+        // OnlyShowIn/NotShowIn against $XDG_CURRENT_DESKTOP, TryExec against the file system
+        bool isShown(const QHash<QString, QString> &entry)
+        {
+            static const QStringList currentDesktops = qEnvironmentVariable("XDG_CURRENT_DESKTOP").split(QLatin1Char(':'), Qt::SkipEmptyParts);
+            const auto isCurrent = [](const QString &desktop) {
+                return currentDesktops.contains(desktop);
+            };
+            const QStringList onlyShowIn = splitList(entry.value(QStringLiteral("OnlyShowIn")), false);
+            if (!onlyShowIn.isEmpty() && std::none_of(onlyShowIn.cbegin(), onlyShowIn.cend(), isCurrent)) {
+                return false;
+            }
+            const QStringList notShowIn = splitList(entry.value(QStringLiteral("NotShowIn")), false);
+            if (std::any_of(notShowIn.cbegin(), notShowIn.cend(), isCurrent)) {
+                return false;
+            }
+            const QString tryExec = entry.value(QStringLiteral("TryExec"));
+            if (!tryExec.isEmpty()) {
+                const QFileInfo program{QDir::isAbsolutePath(tryExec) ? tryExec : QStandardPaths::findExecutable(tryExec)};
+                if (!program.isFile() || !program.isExecutable()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // an empty name means the id is hidden, which also shadows less important files
+        DesktopAppIndex::Application parseDesktopFile(const QString &path, const QString &id)
+        {
+            DesktopAppIndex::Application application;
+            application.id = id;
+            const QHash<QString, QString> entry = readKeyFile(path).value(QStringLiteral("Desktop Entry"));
+            if (entry.value(QStringLiteral("Type")) != QLatin1String("Application") || isTrue(entry.value(QStringLiteral("Hidden")))
+                    || !isShown(entry)) {
+                return application;
+            }
+            const QString locale = QLocale{}.name();
+            application.name = entry.value(QStringLiteral("Name[%1]").arg(locale),
+                entry.value(QStringLiteral("Name[%1]").arg(locale.section(QLatin1Char('_'), 0, 0)),
+                entry.value(QStringLiteral("Name"))));
+            application.icon = entry.value(QStringLiteral("Icon"));
+            application.noDisplay = isTrue(entry.value(QStringLiteral("NoDisplay")));
+            application.mimeTypes = splitList(entry.value(QStringLiteral("MimeType")), false);
+            return application;
+        }
+    }
+
+    static bool s_built = false;
+
+    /*static*/ DesktopAppIndex &DesktopAppIndex::instance()
+    {
+        static DesktopAppIndex index;
+        return index;
+    }
+
+    /*static*/ bool DesktopAppIndex::isBuilt()
+    {
+        return s_built;
+    }
+
+    DesktopAppIndex::DesktopAppIndex()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        for (const QString &dataDir : QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation)) {
+            m_appDirs << dataDir + QStringLiteral("/applications");
+        }
+        m_appDirs.removeDuplicates();
+        // config before data dirs, the user's first; in each directory the desktop
+        // specific list before the generic one
+        QStringList listDirs = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation);
+        listDirs << m_appDirs;
+        for (const QString &dir : listDirs) {
+            for (const QString &name : {QStringLiteral("lxqt-mimeapps.list"), QStringLiteral("mimeapps.list")}) {
+                m_associationFiles << dir + QLatin1Char('/') + name;
+            }
+        }
+
+        connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &directory) {
+            if (m_appDirs.contains(directory) || directory.contains(QLatin1String("/applications/"))) {
+                scanDirectory(directory);
+            }
+            // a mimeapps.list was created, replaced or removed
+            for (const QString &file : m_associationFiles) {
+                if (QFileInfo{file}.absolutePath() == directory) {
+                    readAssociations(file);
+                }
+            }
+        });
+        connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &DesktopAppIndex::readAssociations);
+
+        for (const QString &dir : m_appDirs) {
+            scanDirectory(dir);
+        }
+        for (const QString &file : m_associationFiles) {
+            readAssociations(file);
+        }
+        for (const QString &dir : listDirs) {
+            if (QFileInfo::exists(dir)) {
+                m_watcher.addPath(dir);
+            }
+        }
+        s_built = true;
+        qCDebug(XdgDesktopPortalLxqtApps) << "Indexed" << m_applications.size() << "applications in" << timer.elapsed() << "ms";
+    }
+
+    void DesktopAppIndex::scanDirectory(const QString &directory)
+    {
+        // the applications/ root this directory belongs to gives the id prefix
+        QString root;
+        for (const QString &appDir : m_appDirs) {
+            if (directory == appDir || directory.startsWith(appDir + QLatin1Char('/'))) {
+                root = appDir;
+                break;
+            }
+        }
+        if (root.isEmpty()) {
+            return;
+        }
+
+        QSet<QString> changedIds;
+        QSet<QString> seen;
+        QDirIterator it{directory, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot};
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo info = it.fileInfo();
+            if (info.isDir()) {
+                // subdirectories (e.g. kde4/) contribute "kde4-<name>" ids
+                if (!m_watcher.directories().contains(info.filePath())) {
+                    m_watcher.addPath(info.filePath());
+                    scanDirectory(info.filePath());
+                }
+                continue;
+            }
+            if (info.suffix() != QLatin1String("desktop")) {
+                continue;
+            }
+            const QString path = info.filePath();
+            seen.insert(path);
+            const QDateTime modified = info.lastModified();
+            auto known = m_files.find(path);
+            if (known != m_files.end() && known->modified == modified) {
+                continue;
+            }
+            QString id = path.mid(root.size() + 1);
+            id.chop(8);
+            id.replace(QLatin1Char('/'), QLatin1Char('-'));
+            if (known == m_files.end()) {
+                m_pathsById[id].append(path);
+            }
+            m_files.insert(path, DesktopFile{id, modified});
+            changedIds.insert(id);
+        }
+        // removed files
+        for (auto file = m_files.begin(); file != m_files.end();) {
+            if (QFileInfo{file.key()}.absolutePath() == directory && !seen.contains(file.key())) {
+                changedIds.insert(file->id);
+                m_pathsById[file->id].removeAll(file.key());
+                file = m_files.erase(file);
+            } else {
+                ++file;
+            }
+        }
+        if (!m_watcher.directories().contains(directory) && QFileInfo::exists(directory)) {
+            m_watcher.addPath(directory);
+        }
+        if (!changedIds.isEmpty()) {
+            updateApplications(changedIds);
+        }
+    }
+
+    void DesktopAppIndex::updateApplications(const QSet<QString> &ids)
+    {
+        for (const QString &id : ids) {
+            // drop the old declaration
+            const auto old = m_applications.constFind(id);
+            if (old != m_applications.cend()) {
+                for (const QString &mimeType : old->mimeTypes) {
+                    m_byMimeType[mimeType].removeAll(id);
+                }
+                m_applications.erase(old);
+            }
+
+            // the file in the most important directory wins
+            QString path;
+            int rank = m_appDirs.size();
+            for (const QString &candidate : m_pathsById.value(id)) {
+                for (int i = 0; i < rank; ++i) {
+                    if (candidate.startsWith(m_appDirs.at(i) + QLatin1Char('/'))) {
+                        path = candidate;
+                        rank = i;
+                        break;
+                    }
+                }
+            }
+            if (path.isEmpty()) {
+                continue;
+            }
+            const Application application = parseDesktopFile(path, id);
+            if (!application.name.isEmpty()) {
+                for (const QString &mimeType : application.mimeTypes) {
+                    m_byMimeType[mimeType].append(id);
+                }
+                m_applications.insert(id, application);
+            }
+        }
+        invalidate();
+    }
+
+    void DesktopAppIndex::readAssociations(const QString &file)
+    {
+        if (!m_associationFiles.contains(file)) {
+            return;
+        }
+        Associations associations;
+        if (QFileInfo::exists(file)) {
+            const KeyFile list = readKeyFile(file);
+            const auto readGroup = [&list](const QString &group, QHash<QString, QStringList> &target) {
+                const QHash<QString, QString> entries = list.value(group);
+                for (auto entry = entries.cbegin(); entry != entries.cend(); ++entry) {
+                    target.insert(entry.key(), splitList(entry.value(), true));
+                }
+            };
+            readGroup(QStringLiteral("Default Applications"), associations.defaults);
+            readGroup(QStringLiteral("Added Associations"), associations.added);
+            readGroup(QStringLiteral("Removed Associations"), associations.removed);
+            if (!m_watcher.files().contains(file)) {
+                m_watcher.addPath(file);
+            }
+        }
+        m_associations.insert(file, associations);
+        invalidate();
+    }
+
+    void DesktopAppIndex::invalidate()
+    {
+        m_lookupCache.clear();
+        Q_EMIT changed();
+    }
+
+    const DesktopAppIndex::Application *DesktopAppIndex::application(const QString &id) const
+    {
+        const auto it = m_applications.constFind(id);
+        return it == m_applications.cend() ? nullptr : &it.value();
+    }
+
+    QString DesktopAppIndex::defaultFor(const QString &mimeType)
+    {
+        // removals only cancel what less important files list
+        QSet<QString> removed;
+        for (const QString &file : m_associationFiles) {
+            const Associations associations = m_associations.value(file);
+            for (const QString &id : associations.defaults.value(mimeType)) {
+                if (!removed.contains(id) && m_applications.contains(id)) {
+                    return id;
+                }
+            }
+            for (const QString &id : associations.removed.value(mimeType)) {
+                removed.insert(id);
+            }
+        }
+        return QString();
+    }
+
+    QStringList DesktopAppIndex::applicationsFor(const QString &mimeType)
+    {
+        auto cached = m_lookupCache.constFind(mimeType);
+        if (cached == m_lookupCache.cend()) {
+            cached = m_lookupCache.insert(mimeType, collectFor(mimeType));
+        }
+        return cached.value();
+    }
+
+    QStringList DesktopAppIndex::collectFor(const QString &mimeType) const
+    {
+        QStringList types{mimeType};
+        // the shared-mime-info subclass data, already in memory in QMimeDatabase
+        const QMimeType type = QMimeDatabase{}.mimeTypeForName(mimeType);
+        if (type.isValid()) {
+            types << type.name() << type.aliases() << type.allAncestors();
+            types.removeDuplicates();
+        }
+
+        // Removed Associations of a file only cancel what less important files and the
+        // .desktop files add; removedBefore[i] holds the removals of the files before i
+        QList<QSet<QString>> removedBefore;
+        QSet<QString> removed;
+        for (const QString &file : m_associationFiles) {
+            removedBefore << removed;
+            const Associations associations = m_associations.value(file);
+            for (const QString &t : types) {
+                for (const QString &id : associations.removed.value(t)) {
+                    removed.insert(id);
+                }
+            }
+        }
+
+        QStringList result;
+        const auto add = [this, &result](const QString &id, const QSet<QString> &cancelled) {
+            if (!cancelled.contains(id) && !result.contains(id) && m_applications.contains(id)) {
+                result << id;
+            }
+        };
+        for (const QString &t : types) {
+            for (int i = 0; i < m_associationFiles.size(); ++i) {
+                for (const QString &id : m_associations.value(m_associationFiles.at(i)).defaults.value(t)) {
+                    add(id, removedBefore.at(i));
+                }
+            }
+            for (int i = 0; i < m_associationFiles.size(); ++i) {
+                for (const QString &id : m_associations.value(m_associationFiles.at(i)).added.value(t)) {
+                    add(id, removedBefore.at(i));
+                }
+            }
+            for (const QString &id : m_byMimeType.value(t)) {
+                add(id, removed);
+            }
+        }
+        return result;
+    }
+}
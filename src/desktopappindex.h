@@ -0,0 +1,116 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+namespace LXQt
+{
+    // In-memory index of the installed applications and the MIME types they handle, kept
+    // current from inotify: a change in an applications/ directory re-reads only the
+    // .desktop files whose mtime changed, a change of a mimeapps.list re-reads that file.
+    // Lookups are served from a per-type cache that is dropped whenever the index changes.
+    // Entries that are Hidden, not shown in $XDG_CURRENT_DESKTOP (OnlyShowIn/NotShowIn) or
+    // whose TryExec program is missing are left out, and shadow less important files.
+    class DesktopAppIndex : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        struct Application
+        {
+            // desktop file id without ".desktop", e.g. "org.kde.kate"
+            QString id;
+            QString name;
+            QString icon;
+            QStringList mimeTypes;
+            bool noDisplay = false;
+        };
+
+        static DesktopAppIndex &instance();
+        // whether instance() has already scanned the applications, i.e. is cheap to call
+        static bool isBuilt();
+
+        const Application *application(const QString &id) const;
+
+        // Applications for mimeType, best first: defaults from mimeapps.list, added
+        // associations, then applications declaring the type, then those declaring one of
+        // its parent types (text/plain for text/x-csrc and so on). Removed associations
+        // leave out what less important lists and the .desktop files associate.
+        QStringList applicationsFor(const QString &mimeType);
+
+        QString defaultFor(const QString &mimeType);
+
+    Q_SIGNALS:
+        void changed();
+
+    private:
+        DesktopAppIndex();
+
+        struct DesktopFile
+        {
+            QString id;
+            QDateTime modified;
+        };
+
+        struct Associations
+        {
+            QHash<QString, QStringList> defaults;
+            QHash<QString, QStringList> added;
+            QHash<QString, QStringList> removed;
+        };
+
+        void scanDirectory(const QString &directory);
+        void updateApplications(const QSet<QString> &ids);
+        void readAssociations(const QString &file);
+        QStringList collectFor(const QString &mimeType) const;
+        void invalidate();
+
+    private:
+        // applications/ directories, most important first
+        QStringList m_appDirs;
+        // mimeapps.list files, most important first: per directory lxqt-mimeapps.list, then
+        // mimeapps.list; ~/.config, the XDG config dirs, then the applications/ dirs
+        QStringList m_associationFiles;
+
+        // path of every .desktop file below m_appDirs
+        QHash<QString, DesktopFile> m_files;
+        // the same id can be installed in several directories
+        QHash<QString, QStringList> m_pathsById;
+        QHash<QString, Application> m_applications;
+        // declared in the .desktop files
+        QHash<QString, QStringList> m_byMimeType;
+        QHash<QString, Associations> m_associations;
+
+        QHash<QString, QStringList> m_lookupCache;
+        QFileSystemWatcher m_watcher;
+    };
+}
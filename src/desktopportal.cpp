@@ -28,15 +28,27 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "access.h"
+#include "appchooser.h"
 #include "desktopportal.h"
 #include "filechooser.h"
+#include "notification.h"
+#include "print.h"
+#include "screenshot.h"
+#include "settings.h"
+#include "wallpaper.h"
 
 namespace LXQt
 {
     DesktopPortal::DesktopPortal(QObject *parent)
         : QObject(parent)
         , m_access{new AccessPortal{this}}
+        , m_appChooser{new AppChooserPortal{this}}
         , m_fileChooser{new FileChooserPortal{this}}
+        , m_notification{new NotificationPortal{this}}
+        , m_print{new PrintPortal{this}}
+        , m_screenshot{new ScreenshotPortal{this}}
+        , m_settings{new SettingsPortal{this}}
+        , m_wallpaper{new WallpaperPortal{this}}
     {
     }
 }
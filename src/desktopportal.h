@@ -35,8 +35,18 @@
 namespace LXQt
 {
     class AccessPortal;
+    class AppChooserPortal;
     class FileChooserPortal;
+    class NotificationPortal;
+    class PrintPortal;
+    class ScreenshotPortal;
+    class SettingsPortal;
+    class WallpaperPortal;
 
+    // Owns one adaptor per exported interface. They have to exist when the object is
+    // registered, so they stay cheap: metatype registration at most. What an interface
+    // needs beyond that (libfm-qt, application index, notification server subscription,
+    // settings files and their watches, worker threads) is created on its first call.
     class DesktopPortal : public QObject, public QDBusContext
     {
         Q_OBJECT
@@ -45,6 +55,12 @@ namespace LXQt
 
     private:
         AccessPortal *m_access;
+        AppChooserPortal *m_appChooser;
         FileChooserPortal *m_fileChooser;
+        NotificationPortal *m_notification;
+        PrintPortal *m_print;
+        ScreenshotPortal *m_screenshot;
+        SettingsPortal *m_settings;
+        WallpaperPortal *m_wallpaper;
     };
 }
@@ -0,0 +1,140 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "dialogsearch.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QLabel>
+#include <QLayout>
+#include <QLineEdit>
+#include <QListWidget>
+
+#include <libfm-qt6/filedialog.h>
+
+namespace LXQt
+{
+    // typing pauses shorter than this do not restart the walk
+    static constexpr int RestartDelay = 250;
+    // single characters match nearly everything in a large tree
+    static constexpr int MinimumQueryLength = 2;
+
+    /*static*/ void DialogSearch::attach(Fm::FileDialog &dialog, FileSearch::Target target)
+    {
+        if (dialog.layout() == nullptr) {
+            return;
+        }
+        new DialogSearch{dialog, target};
+    }
+
+    DialogSearch::DialogSearch(Fm::FileDialog &dialog, FileSearch::Target target)
+        : QObject{&dialog}
+        , m_dialog{dialog}
+        , m_target{target}
+        , m_field{new QLineEdit}
+        , m_results{new QListWidget}
+        , m_status{new QLabel}
+    {
+        m_field->setPlaceholderText(tr("Search in this folder and its subfolders"));
+        m_field->setClearButtonEnabled(true);
+        m_results->setUniformItemSizes(true);
+        m_results->hide();
+        m_status->hide();
+
+        auto layout = dialog.layout();
+        layout->addWidget(m_field);
+        layout->addWidget(m_results);
+        layout->addWidget(m_status);
+
+        m_restartTimer.setSingleShot(true);
+        m_restartTimer.setInterval(RestartDelay);
+        connect(&m_restartTimer, &QTimer::timeout, this, &DialogSearch::restart);
+        connect(m_field, &QLineEdit::textChanged, &m_restartTimer, [this] { m_restartTimer.start(); });
+        connect(&dialog, &Fm::FileDialog::directoryEntered, this, [this] {
+            // opening a result's folder keeps the results
+            if (!m_navigating) {
+                restart();
+            }
+        });
+        connect(&dialog, &Fm::FileDialog::filterSelected, this, &DialogSearch::restart);
+        connect(&m_search, &FileSearch::resultsFound, this, &DialogSearch::addResults);
+        connect(&m_search, &FileSearch::finished, this, &DialogSearch::searchFinished);
+        connect(m_results, &QListWidget::itemActivated, this, &DialogSearch::activate);
+    }
+
+    void DialogSearch::restart()
+    {
+        m_restartTimer.stop();
+        m_search.cancel();
+        m_results->clear();
+
+        const QString query = m_field->text().trimmed();
+        const QUrl directory = m_dialog.directory();
+        if (query.size() < MinimumQueryLength || !directory.isLocalFile()) {
+            m_results->hide();
+            m_status->hide();
+            return;
+        }
+
+        m_root = QDir::cleanPath(directory.toLocalFile());
+        m_results->show();
+        m_status->setText(tr("Searching..."));
+        m_status->show();
+        m_search.start(m_root, query, FileSearch::patternsFromNameFilter(m_dialog.selectedNameFilter()), m_target);
+    }
+
+    void DialogSearch::addResults(const QStringList &paths)
+    {
+        const QDir root{m_root};
+        m_results->setUpdatesEnabled(false);
+        for (const QString &path : paths) {
+            auto item = new QListWidgetItem{root.relativeFilePath(path), m_results};
+            item->setData(Qt::UserRole, path);
+            item->setToolTip(path);
+        }
+        m_results->setUpdatesEnabled(true);
+        m_status->setText(tr("Searching... %n found", nullptr, m_results->count()));
+    }
+
+    void DialogSearch::searchFinished(bool complete)
+    {
+        if (!complete) {
+            m_status->setText(tr("Search stopped at a limit, %n found. Refine the search or open a subfolder.", nullptr, m_results->count()));
+        } else if (m_results->count() == 0) {
+            m_status->setText(tr("Nothing found"));
+        } else {
+            m_status->setText(tr("%n found", nullptr, m_results->count()));
+        }
+    }
+
+    void DialogSearch::activate(QListWidgetItem *item)
+    {
+        const QFileInfo info{item->data(Qt::UserRole).toString()};
+        m_navigating = true;
+        m_dialog.setDirectory(QUrl::fromLocalFile(info.absolutePath()));
+        m_dialog.selectFile(QUrl::fromLocalFile(info.absoluteFilePath()));
+        m_navigating = false;
+    }
+}
@@ -0,0 +1,76 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include "filesearch.h"
+
+#include <QObject>
+#include <QTimer>
+
+class QLabel;
+class QLineEdit;
+class QListWidget;
+class QListWidgetItem;
+
+namespace Fm
+{
+    class FileDialog;
+}
+
+namespace LXQt
+{
+    // Search field below a file dialog's view: typing searches the current folder and its
+    // subfolders for names containing the text and matching the active name filter, and
+    // results are listed as they are found. Activating a result opens its folder in the
+    // dialog and selects it.
+    class DialogSearch : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // the search is owned by the dialog; does nothing if the dialog has no layout
+        static void attach(Fm::FileDialog &dialog, FileSearch::Target target);
+
+    private:
+        DialogSearch(Fm::FileDialog &dialog, FileSearch::Target target);
+
+        void restart();
+        void addResults(const QStringList &paths);
+        void searchFinished(bool complete);
+        void activate(QListWidgetItem *item);
+
+    private:
+        Fm::FileDialog &m_dialog;
+        FileSearch::Target m_target;
+        FileSearch m_search;
+        QString m_root;
+        QTimer m_restartTimer;
+        QLineEdit *m_field;
+        QListWidget *m_results;
+        QLabel *m_status;
+        bool m_navigating = false;
+    };
+}
@@ -0,0 +1,217 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "dialogworker.h"
+#include "choices.h"
+#include "filechooser.h"
+#include "filedialoghelper.h"
+#include "filters.h"
+#include "portalsettings.h"
+#include "portaltrace.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QEventLoop>
+#include <QFile>
+#include <QIcon>
+#include <QLoggingCategory>
+#include <QProcess>
+#include <QUrl>
+
+#include <unistd.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtDialogWorker, "xdp-lxqt-dialog-worker")
+
+    // set in worker processes, which serve their request in-process
+    static bool s_isWorker = false;
+
+    // peak resident set size of this process in kB
+    static qint64 peakRss()
+    {
+        QFile status{QStringLiteral("/proc/self/status")};
+        if (!status.open(QIODevice::ReadOnly)) {
+            return 0;
+        }
+        while (!status.atEnd()) {
+            const QByteArray line = status.readLine();
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').value(0).toLongLong();
+            }
+        }
+        return 0;
+    }
+
+    /*static*/ bool DialogWorkerPool::enabled()
+    {
+        return !s_isWorker && PortalSettings::instance().dialogWorkers();
+    }
+
+    /*static*/ DialogWorkerPool &DialogWorkerPool::instance()
+    {
+        // owned by the application, so a waiting spare is stopped before Qt goes away
+        static DialogWorkerPool *pool = [] {
+            auto pool = new DialogWorkerPool;
+            pool->setParent(QCoreApplication::instance());
+            return pool;
+        }();
+        return *pool;
+    }
+
+    QProcess *DialogWorkerPool::spawn()
+    {
+        auto process = new QProcess{this};
+        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+        // the daemon records the calls
+        environment.remove(QStringLiteral("XDG_DESKTOP_PORTAL_LXQT_TRACE"));
+        process->setProcessEnvironment(environment);
+        process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        process->start(QCoreApplication::applicationFilePath(), {QStringLiteral("--dialog-worker")});
+        m_spareAge.start();
+        return process;
+    }
+
+    uint DialogWorkerPool::run(FileChooserPortal *portal, const QString &method, const QStringList &arguments, const QVariantMap &options, QVariantMap &results)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        // a spare that had no time to initialise is still faster than a cold start
+        QProcess *worker = m_spare ? m_spare : spawn();
+        const qint64 spareAge = m_spare ? m_spareAge.elapsed() : 0;
+        m_spare = spawn();
+
+        const QString parentWindow = arguments.value(1);
+        QStringList requestArguments = arguments;
+        requestArguments << portal->lastVisitedDir(parentWindow).toString();
+        const TraceRecord request = TraceRecorder::toRecord(method, requestArguments, options);
+        {
+            QDataStream out{worker};
+            out.setVersion(QDataStream::Qt_6_0);
+            out << request.serialize();
+        }
+        worker->closeWriteChannel();
+        const qint64 pid = worker->processId();
+
+        if (worker->state() != QProcess::NotRunning) {
+            QEventLoop loop;
+            connect(worker, &QProcess::finished, &loop, &QEventLoop::quit);
+            connect(worker, &QProcess::errorOccurred, &loop, [&loop](QProcess::ProcessError error) {
+                if (error == QProcess::FailedToStart) {
+                    loop.quit();
+                }
+            });
+            loop.exec();
+        }
+
+        QDataStream in{worker->readAllStandardOutput()};
+        in.setVersion(QDataStream::Qt_6_0);
+        QByteArray payload;
+        in >> payload;
+        TraceRecord response;
+        const bool ok = worker->exitStatus() == QProcess::NormalExit && worker->exitCode() == 0 && in.status() == QDataStream::Ok
+                && response.deserialize(payload) && response.method == QLatin1String("Response");
+        const QString failure = worker->exitStatus() == QProcess::CrashExit ? QStringLiteral("crashed") : QStringLiteral("exited with %1").arg(worker->exitCode());
+        worker->deleteLater();
+
+        if (!ok) {
+            qCWarning(XdgDesktopPortalLxqtDialogWorker) << "Dialog worker" << pid << "for" << method << failure;
+            return 2;
+        }
+
+        results = response.dbusOptions();
+        const QUrl lastVisitedDir{response.arguments.value(1)};
+        if (lastVisitedDir.isValid()) {
+            portal->setLastVisitedDir(parentWindow, lastVisitedDir);
+        }
+        qCDebug(XdgDesktopPortalLxqtDialogWorker) << method << "served by worker" << pid << "in" << timer.elapsed() << "ms;"
+                                                  << "spare started" << spareAge << "ms before, initialised in" << response.arguments.value(2) << "ms,"
+                                                  << "idle for" << response.arguments.value(3) << "ms, peak RSS" << response.arguments.value(4) << "kB";
+        return response.arguments.value(0).toUInt();
+    }
+
+    /*static*/ int DialogWorkerPool::exec()
+    {
+        s_isWorker = true;
+        QElapsedTimer timer;
+        timer.start();
+
+        // the protocol owns stdout, anything else printed there goes to stderr
+        const int protocolFd = dup(STDOUT_FILENO);
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+
+        // what a request shouldn't have to wait for
+        registerFilterMetaTypes();
+        registerChoiceMetaTypes();
+        FileDialogHelper::initLibFmQt();
+        QIcon::fromTheme(QStringLiteral("folder")).pixmap(16);
+        const qint64 initTime = timer.elapsed();
+
+        // blocks until a request arrives; EOF when the daemon exits
+        QFile input;
+        input.open(STDIN_FILENO, QIODevice::ReadOnly);
+        QDataStream in{&input};
+        in.setVersion(QDataStream::Qt_6_0);
+        QByteArray payload;
+        in >> payload;
+        TraceRecord request;
+        if (in.status() != QDataStream::Ok || !request.deserialize(payload)) {
+            return 1;
+        }
+        const qint64 idleTime = timer.elapsed() - initTime;
+
+        QObject holder;
+        auto portal = new FileChooserPortal{&holder};
+        const QString parentWindow = request.arguments.value(1);
+        const QUrl lastVisitedDir{request.arguments.value(3)};
+        if (lastVisitedDir.isValid()) {
+            portal->setLastVisitedDir(parentWindow, lastVisitedDir);
+        }
+
+        const QDBusObjectPath handle{QStringLiteral("/org/freedesktop/portal/desktop/request/worker")};
+        QVariantMap results;
+        uint response = 2;
+        if (request.method == QLatin1String("OpenFile")) {
+            response = portal->OpenFile(handle, request.arguments.value(0), parentWindow, request.arguments.value(2), request.dbusOptions(), QDBusMessage{}, results);
+        } else if (request.method == QLatin1String("SaveFile")) {
+            response = portal->SaveFile(handle, request.arguments.value(0), parentWindow, request.arguments.value(2), request.dbusOptions(), QDBusMessage{}, results);
+        }
+
+        const TraceRecord reply = TraceRecorder::toRecord(QStringLiteral("Response"),
+                {QString::number(response), portal->lastVisitedDir(parentWindow).toString(),
+                    QString::number(initTime), QString::number(idleTime), QString::number(peakRss())},
+                results);
+        QFile output;
+        output.open(protocolFd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle);
+        QDataStream out{&output};
+        out.setVersion(QDataStream::Qt_6_0);
+        out << reply.serialize();
+        output.flush();
+        return 0;
+    }
+}
@@ -0,0 +1,72 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+class QProcess;
+
+namespace LXQt
+{
+    class FileChooserPortal;
+
+    // Optional out-of-process file dialogs ([FileDialog] DialogWorkers=true).
+    //
+    // A spare worker (this executable started with --dialog-worker) is kept ready with Qt,
+    // the platform theme and libfm-qt initialised, waiting for one request on stdin. An
+    // OpenFile/SaveFile hands its arguments to the spare (the first one, to a worker started
+    // for it), serialised like a trace record, starts the next spare and waits in a nested
+    // event loop until the worker writes the response and exits. The folder models, thumbnails and previews of a dialog thus go
+    // away with its process, and a crashing view only fails its own request.
+    //
+    // Workers are started rather than forked from a template: a forked copy would share
+    // the template's X11 connection and could inherit locked mutexes of Qt and GLib
+    // threads.
+    class DialogWorkerPool : public QObject
+    {
+        Q_OBJECT
+    public:
+        // true in the daemon when dialog workers are configured
+        static bool enabled();
+        static DialogWorkerPool &instance();
+
+        uint run(FileChooserPortal *portal, const QString &method, const QStringList &arguments, const QVariantMap &options, QVariantMap &results);
+
+        // main loop of a worker process, serves one request
+        static int exec();
+
+    private:
+        DialogWorkerPool() = default;
+        QProcess *spawn();
+
+    private:
+        QProcess *m_spare = nullptr;
+        QElapsedTimer m_spareAge;
+    };
+}
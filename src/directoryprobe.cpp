@@ -0,0 +1,180 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "directoryprobe.h"
+#include "mounttable.h"
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QTimer>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtProbe, "xdp-lxqt-probe")
+
+    namespace
+    {
+        struct SlowMount {
+            // a probe into this mount is still blocked
+            bool pending = true;
+            QDeadlineTimer expiry;
+        };
+
+        QMutex slowMountsMutex;
+        // signalled with slowMountsMutex locked whenever a probe sets its result
+        QWaitCondition probeDone;
+        QHash<QString, SlowMount> slowMounts;
+
+        bool isKnownSlow(const QString &mountPoint)
+        {
+            QMutexLocker locker{&slowMountsMutex};
+            auto it = slowMounts.find(mountPoint);
+            if (it == slowMounts.end()) {
+                return false;
+            }
+            if (it->pending || !it->expiry.hasExpired()) {
+                return true;
+            }
+            slowMounts.erase(it);
+            return false;
+        }
+
+        // called from the probe thread with slowMountsMutex locked
+        void probeFinished(const QString &mountPoint)
+        {
+            auto it = slowMounts.find(mountPoint);
+            if (it != slowMounts.end()) {
+                it->pending = false;
+                it->expiry.setRemainingTime(DirectoryProbe::SlowMountExpiry);
+            }
+        }
+    }
+
+    struct DirectoryProbe::State {
+        // set once, with slowMountsMutex locked: by the thread or by a timed out wait()
+        std::atomic<int> result{-1};
+        // only touched in the GUI thread
+        QEventLoop *loop = nullptr;
+    };
+
+    QString DirectoryProbe::mountPointOf(const QString &path)
+    {
+        return MountTable::mountPointOf(path);
+    }
+
+    /*static*/ DirectoryProbe::Pending DirectoryProbe::start(const QUrl &url, int timeoutMs)
+    {
+        Pending pending;
+        pending.m_state = std::make_shared<State>();
+        pending.m_deadline.setRemainingTime(timeoutMs);
+        if (!url.isLocalFile()) {
+            pending.m_state->result = Reachable;
+            return pending;
+        }
+
+        pending.m_path = url.toLocalFile();
+        pending.m_mountPoint = mountPointOf(pending.m_path);
+        if (isKnownSlow(pending.m_mountPoint)) {
+            qCDebug(XdgDesktopPortalLxqtProbe) << "Skipping" << pending.m_path << "on slow mount" << pending.m_mountPoint;
+            pending.m_state->result = TimedOut;
+            return pending;
+        }
+
+        std::thread{[state = pending.m_state, localPath = QFile::encodeName(pending.m_path), mountPoint = pending.m_mountPoint] {
+            struct stat st;
+            const bool ok = ::stat(localPath.constData(), &st) == 0 && S_ISDIR(st.st_mode)
+                && ::access(localPath.constData(), R_OK | X_OK) == 0;
+            {
+                // the result and the slow mount bookkeeping change together, see wait()
+                QMutexLocker locker{&slowMountsMutex};
+                if (state->result < 0) {
+                    state->result = ok ? Reachable : Unreachable;
+                }
+                probeFinished(mountPoint);
+                probeDone.wakeAll();
+            }
+            if (auto app = QCoreApplication::instance()) {
+                QMetaObject::invokeMethod(app, [state] {
+                    if (state->loop) {
+                        state->loop->quit();
+                    }
+                }, Qt::QueuedConnection);
+            }
+        }}.detach();
+        return pending;
+    }
+
+    bool DirectoryProbe::Pending::isFinished() const
+    {
+        return m_state && m_state->result >= 0;
+    }
+
+    DirectoryProbe::Result DirectoryProbe::Pending::wait()
+    {
+        if (!m_state) {
+            return Unreachable;
+        }
+        bool timedOut = false;
+        {
+            QMutexLocker locker{&slowMountsMutex};
+            while (m_state->result < 0 && !m_deadline.hasExpired()) {
+                probeDone.wait(&slowMountsMutex, m_deadline);
+            }
+            if (m_state->result < 0) {
+                m_state->result = TimedOut;
+                slowMounts.insert(m_mountPoint, SlowMount{});
+                timedOut = true;
+            }
+        }
+        if (timedOut) {
+            qCWarning(XdgDesktopPortalLxqtProbe) << m_path << "did not respond in time, marking" << m_mountPoint << "as slow";
+        }
+        return static_cast<Result>(m_state->result.load());
+    }
+
+    /*static*/ DirectoryProbe::Result DirectoryProbe::probe(const QUrl &url, int timeoutMs)
+    {
+        Pending pending = start(url, timeoutMs);
+        if (!pending.isFinished()) {
+            QEventLoop loop;
+            pending.m_state->loop = &loop;
+            QTimer::singleShot(pending.m_deadline.remainingTime(), &loop, &QEventLoop::quit);
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+            pending.m_state->loop = nullptr;
+        }
+        return pending.wait();
+    }
+}
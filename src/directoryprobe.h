@@ -0,0 +1,85 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDeadlineTimer>
+#include <QString>
+#include <QUrl>
+
+#include <memory>
+
+namespace LXQt
+{
+    // Checks that a local directory responds before the dialog is pointed at it, so a stale
+    // NFS/SSHFS/CIFS mount cannot freeze the portal. The filesystem calls run on a detached
+    // thread; if they don't finish in time the caller gets TimedOut, the probe keeps running
+    // in the background and the mount point is remembered as slow, so later requests into
+    // it are rejected right away.
+    class DirectoryProbe
+    {
+        struct State;
+
+    public:
+        enum Result {
+            Reachable,
+            Unreachable,
+            TimedOut
+        };
+
+        static constexpr int DefaultTimeout = 400;
+        // how long a mount stays marked as slow after its last probe finished
+        static constexpr int SlowMountExpiry = 60 * 1000;
+
+        // A probe running on its own thread, see start()
+        class Pending
+        {
+        public:
+            bool isFinished() const;
+            // Blocks until the probe finishes or its deadline passes. No event loop runs
+            // meanwhile, so other D-Bus calls cannot come in.
+            Result wait();
+
+        private:
+            friend class DirectoryProbe;
+            std::shared_ptr<State> m_state;
+            QString m_path;
+            QString m_mountPoint;
+            QDeadlineTimer m_deadline;
+        };
+
+        // Starts probing url and returns right away; the timeout counts from here.
+        // Non-local URLs are not probed and reported as Reachable.
+        static Pending start(const QUrl &url, int timeoutMs = DefaultTimeout);
+
+        // Probes url while running a nested event loop (user input excluded), for places
+        // the user picks in an open dialog.
+        static Result probe(const QUrl &url, int timeoutMs = DefaultTimeout);
+
+        // Longest mount point containing path, taken from /proc/self/mountinfo without
+        // touching the mount itself.
+        static QString mountPointOf(const QString &path);
+    };
+}
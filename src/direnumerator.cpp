@@ -0,0 +1,180 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "direnumerator.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace LXQt
+{
+    namespace
+    {
+        bool isDotOrDotDot(const char *name)
+        {
+            return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+        }
+
+        // Resolves what d_type couldn't tell; returns false if the entry vanished.
+        bool classify(int dirFd, const char *name, unsigned char type, DirEnumerator::Entry &entry)
+        {
+            entry.isSymlink = type == DT_LNK;
+            entry.isDirectory = type == DT_DIR;
+            struct stat st;
+            if (type == DT_UNKNOWN) {
+                // one lstat tells everything but the target of a symlink
+                if (::fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                    return false;
+                }
+                entry.isSymlink = S_ISLNK(st.st_mode);
+                entry.isDirectory = S_ISDIR(st.st_mode);
+            }
+            if (entry.isSymlink) {
+                // follow symlinks, a link to a folder is offered as a folder
+                if (::fstatat(dirFd, name, &st, 0) != 0) {
+                    return true; // dangling symlink
+                }
+                entry.isDirectory = S_ISDIR(st.st_mode);
+            }
+            return true;
+        }
+
+        bool wanted(unsigned char type, DirEnumerator::Mode mode)
+        {
+            // anything that is neither a folder nor possibly one is skipped without a syscall
+            return mode == DirEnumerator::AllEntries || type == DT_DIR || type == DT_LNK || type == DT_UNKNOWN;
+        }
+    }
+
+    int DirEnumerator::open(const QByteArray &path)
+    {
+        return ::open(path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    }
+
+    int DirEnumerator::openAt(int dirFd, const char *name)
+    {
+        return ::openat(dirFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW);
+    }
+
+#ifdef __linux__
+    bool DirEnumerator::enumerate(int dirFd, Mode mode, const Visitor &visitor)
+    {
+        // layout of the records returned by the getdents64 syscall
+        struct LinuxDirent64 {
+            quint64 d_ino;
+            qint64 d_off;
+            unsigned short d_reclen;
+            unsigned char d_type;
+            char d_name[1];
+        };
+
+        if (dirFd < 0) {
+            return false;
+        }
+        alignas(LinuxDirent64) char buffer[64 * 1024];
+        for (;;) {
+            const long read = ::syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+            if (read < 0) {
+                return false;
+            }
+            if (read == 0) {
+                return true;
+            }
+            for (long offset = 0; offset < read;) {
+                const auto dirent = reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+                offset += dirent->d_reclen;
+                if (isDotOrDotDot(dirent->d_name) || !wanted(dirent->d_type, mode)) {
+                    continue;
+                }
+                Entry entry;
+                if (!classify(dirFd, dirent->d_name, dirent->d_type, entry)) {
+                    continue;
+                }
+                if (mode == DirectoriesOnly && !entry.isDirectory) {
+                    continue;
+                }
+                entry.name = dirent->d_name;
+                entry.nameLength = static_cast<int>(qstrlen(dirent->d_name));
+                if (!visitor(entry)) {
+                    return true;
+                }
+            }
+        }
+    }
+#else
+    bool DirEnumerator::enumerate(int dirFd, Mode mode, const Visitor &visitor)
+    {
+        // readdir() takes over the fd, so work on a duplicate
+        const int fd = dirFd >= 0 ? ::dup(dirFd) : -1;
+        DIR *dir = fd >= 0 ? ::fdopendir(fd) : nullptr;
+        if (!dir) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return false;
+        }
+        ::rewinddir(dir);
+        while (const struct dirent *dirent = ::readdir(dir)) {
+            if (isDotOrDotDot(dirent->d_name) || !wanted(dirent->d_type, mode)) {
+                continue;
+            }
+            Entry entry;
+            if (!classify(dirFd, dirent->d_name, dirent->d_type, entry)) {
+                continue;
+            }
+            if (mode == DirectoriesOnly && !entry.isDirectory) {
+                continue;
+            }
+            entry.name = dirent->d_name;
+            entry.nameLength = static_cast<int>(qstrlen(dirent->d_name));
+            if (!visitor(entry)) {
+                break;
+            }
+        }
+        ::closedir(dir);
+        return true;
+    }
+#endif
+
+    bool DirEnumerator::list(const QByteArray &path, Mode mode, QList<QByteArray> &names)
+    {
+        const int fd = open(path);
+        if (fd < 0) {
+            return false;
+        }
+        const bool ok = enumerate(fd, mode, [&names](const Entry &entry) {
+            names.append(QByteArray{entry.name, entry.nameLength});
+            return true;
+        });
+        ::close(fd);
+        return ok;
+    }
+}
@@ -0,0 +1,68 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+
+#include <functional>
+
+namespace LXQt
+{
+    // Low-level directory listing for the portal's own filesystem work. On Linux it reads
+    // entries with getdents64 in large batches and relies on d_type, so listing only the
+    // subdirectories of a folder needs no stat() per entry and no MIME detection at all;
+    // fstatat() is only used for symlinks and filesystems that report DT_UNKNOWN.
+    class DirEnumerator
+    {
+    public:
+        enum Mode {
+            AllEntries,
+            DirectoriesOnly
+        };
+
+        struct Entry {
+            // not NUL terminated after the visitor returns, copy it if needed
+            const char *name;
+            int nameLength;
+            bool isDirectory;
+            bool isSymlink;
+        };
+
+        // return false to stop the enumeration
+        using Visitor = std::function<bool(const Entry &entry)>;
+
+        // opens a directory for enumerate(); returns -1 on error
+        static int open(const QByteArray &path);
+        static int openAt(int dirFd, const char *name);
+
+        // Calls visitor for each entry except "." and "..". The fd is not closed.
+        static bool enumerate(int dirFd, Mode mode, const Visitor &visitor);
+
+        // convenience wrapper returning the entry names
+        static bool list(const QByteArray &path, Mode mode, QList<QByteArray> &names);
+    };
+}
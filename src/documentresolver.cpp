@@ -0,0 +1,234 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "documentresolver.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QStandardPaths>
+#include <QStringList>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtDocuments, "xdp-lxqt-documents")
+
+    static const QString DocumentsService = QStringLiteral("org.freedesktop.portal.Documents");
+    static const QString DocumentsPath = QStringLiteral("/org/freedesktop/portal/documents");
+    // the document portal answers from memory; don't let a wedged one stall the dialog
+    static constexpr int CallTimeout = 500;
+    // a failed mount point query is repeated by a request no sooner than this (ms), in
+    // case the portal timed out; a portal that (re)starts is noticed on the bus anyway
+    static constexpr int RetryInterval = 10 * 1000;
+    // an exported file can be moved on the host, so mappings are looked up again eventually
+    static constexpr int CacheLifetime = 300;
+    // a failed lookup may be a portal that was busy or restarting, ask again soon (s)
+    static constexpr int FailedLookupLifetime = 5;
+    static constexpr int MaxCacheEntries = 256;
+
+    static QByteArray chopNul(QByteArray bytes)
+    {
+        while (bytes.endsWith('\0')) {
+            bytes.chop(1);
+        }
+        return bytes;
+    }
+
+    // Sends message and runs a nested event loop until the reply or the call timeout.
+    static QDBusMessage callAndWait(const QDBusMessage &message)
+    {
+        QDBusPendingCall call = QDBusConnection::sessionBus().asyncCall(message, CallTimeout);
+        QDBusPendingCallWatcher watcher{call};
+        if (!watcher.isFinished()) {
+            QEventLoop loop;
+            QObject::connect(&watcher, &QDBusPendingCallWatcher::finished, &loop, &QEventLoop::quit);
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+        }
+        return watcher.reply();
+    }
+
+    /*static*/ DocumentResolver &DocumentResolver::instance()
+    {
+        static DocumentResolver resolver;
+        return resolver;
+    }
+
+    DocumentResolver::DocumentResolver()
+        : m_cache{MaxCacheEntries}
+        , m_serviceWatcher{DocumentsService, QDBusConnection::sessionBus(),
+                  QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration}
+    {
+        // reply type of GetHostPaths
+        qDBusRegisterMetaType<QMap<QString, QByteArray>>();
+        connect(&m_serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, &DocumentResolver::queryMountPoint);
+        connect(&m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &DocumentResolver::portalLost);
+        queryMountPoint();
+    }
+
+    void DocumentResolver::queryMountPoint()
+    {
+        if (m_mountPointCall) {
+            return;
+        }
+        QDBusMessage message = QDBusMessage::createMethodCall(DocumentsService, DocumentsPath, DocumentsService, QStringLiteral("GetMountPoint"));
+        // don't start the document portal just to find out there is nothing to resolve
+        message.setAutoStartService(false);
+        m_mountPointCall = new QDBusPendingCallWatcher{QDBusConnection::sessionBus().asyncCall(message, CallTimeout), this};
+        connect(m_mountPointCall, &QDBusPendingCallWatcher::finished, this, &DocumentResolver::mountPointReplied);
+    }
+
+    void DocumentResolver::mountPointReplied(QDBusPendingCallWatcher *watcher)
+    {
+        // cleared right away, the watcher only goes with deleteLater()
+        m_mountPointCall = nullptr;
+        watcher->deleteLater();
+        const QDBusPendingReply<QByteArray> reply = *watcher;
+        if (reply.isError()) {
+            qCDebug(XdgDesktopPortalLxqtDocuments) << "No document portal mount point:" << reply.error().message();
+            m_sinceFailure.start();
+            return;
+        }
+        m_mountPoint = QFile::decodeName(chopNul(reply.value()));
+        while (m_mountPoint.endsWith(QLatin1Char('/'))) {
+            m_mountPoint.chop(1);
+        }
+        m_sinceFailure.invalidate();
+        qCDebug(XdgDesktopPortalLxqtDocuments) << "Document portal mount point:" << m_mountPoint;
+    }
+
+    void DocumentResolver::portalLost()
+    {
+        // a restarted portal may mount elsewhere and has its own document ids
+        m_mountPoint.clear();
+        m_cache.clear();
+        m_hasGetHostPaths = true;
+    }
+
+    bool DocumentResolver::ensureMountPoint()
+    {
+        if (m_mountPoint.isEmpty() && !m_mountPointCall
+                && (!m_sinceFailure.isValid() || m_sinceFailure.hasExpired(RetryInterval))) {
+            queryMountPoint();
+        }
+        // normally answered long before the first request arrives
+        if (m_mountPointCall) {
+            QEventLoop loop;
+            connect(m_mountPointCall.data(), &QDBusPendingCallWatcher::finished, &loop, &QEventLoop::quit);
+            loop.exec(QEventLoop::ExcludeUserInputEvents);
+        }
+        return !m_mountPoint.isEmpty();
+    }
+
+    QByteArray DocumentResolver::hostPath(const QString &docId)
+    {
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        if (const CacheEntry *cached = m_cache.object(docId)) {
+            if (cached->expiry > now) {
+                return cached->hostPath;
+            }
+        }
+
+        QByteArray path;
+        if (m_hasGetHostPaths) {
+            QDBusMessage message = QDBusMessage::createMethodCall(DocumentsService, DocumentsPath, DocumentsService, QStringLiteral("GetHostPaths"));
+            message << QStringList{docId};
+            const QDBusPendingReply<QMap<QString, QByteArray>> reply = callAndWait(message);
+            if (reply.isValid()) {
+                path = reply.value().value(docId);
+            } else if (reply.error().type() == QDBusError::UnknownMethod) {
+                qCDebug(XdgDesktopPortalLxqtDocuments) << "Document portal has no GetHostPaths, using Info";
+                m_hasGetHostPaths = false;
+            }
+        }
+        if (!m_hasGetHostPaths) {
+            // document portal before version 5
+            QDBusMessage info = QDBusMessage::createMethodCall(DocumentsService, DocumentsPath, DocumentsService, QStringLiteral("Info"));
+            info << docId;
+            const QDBusMessage infoReply = callAndWait(info);
+            if (infoReply.type() == QDBusMessage::ReplyMessage && !infoReply.arguments().isEmpty()) {
+                path = infoReply.arguments().constFirst().toByteArray();
+            }
+        }
+        path = chopNul(path);
+
+        m_cache.insert(docId, new CacheEntry{path, now.addSecs(path.isEmpty() ? FailedLookupLifetime : CacheLifetime)});
+        return path;
+    }
+
+    bool DocumentResolver::mayBeDocument(const QString &path) const
+    {
+        // where the document portal mounts unless it was told otherwise
+        static const QString defaultMountPoint = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation) + QStringLiteral("/doc");
+        const auto isBelow = [&path](const QString &mountPoint) {
+            return !mountPoint.isEmpty() && path.startsWith(mountPoint + QLatin1Char('/'));
+        };
+        return isBelow(m_mountPoint) || (m_mountPoint.isEmpty() && isBelow(defaultMountPoint));
+    }
+
+    QString DocumentResolver::resolve(const QString &path)
+    {
+        // most paths are nowhere near the document portal, they cost no D-Bus call
+        if (path.isEmpty() || !mayBeDocument(path) || !ensureMountPoint() || !path.startsWith(m_mountPoint + QLatin1Char('/'))) {
+            return path;
+        }
+
+        // <id>/<name>[/<more>] or by-app/<app>/<id>/<name>[/<more>]
+        QStringList parts = path.mid(m_mountPoint.size() + 1).split(QLatin1Char('/'), Qt::SkipEmptyParts);
+        if (parts.size() >= 2 && parts.constFirst() == QLatin1String("by-app")) {
+            parts = parts.mid(2);
+        }
+        if (parts.size() < 2) {
+            // the document folder itself has no single host counterpart
+            return path;
+        }
+
+        const QString docId = parts.takeFirst();
+        const QByteArray host = hostPath(docId);
+        if (host.isEmpty()) {
+            return path;
+        }
+        // the first component below the id is the exported file or folder itself
+        const QFileInfo exported{QFile::decodeName(host)};
+        if (exported.fileName() != parts.constFirst()) {
+            return path;
+        }
+        parts.first() = exported.absoluteFilePath();
+        const QString resolved = parts.join(QLatin1Char('/'));
+        // stale mapping (the file was moved since) or a new file below an exported folder
+        // that doesn't exist yet; only use what can be checked
+        if (!QFileInfo::exists(resolved) && !QFileInfo::exists(QFileInfo{resolved}.absolutePath())) {
+            m_cache.remove(docId);
+            return path;
+        }
+        qCDebug(XdgDesktopPortalLxqtDocuments) << "Resolved" << path << "to" << resolved;
+        return resolved;
+    }
+}
@@ -0,0 +1,89 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QDBusServiceWatcher>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class QDBusPendingCallWatcher;
+
+namespace LXQt
+{
+    // Maps paths inside the document portal's FUSE mount (/run/user/$UID/doc/<id>/<name>,
+    // or .../doc/by-app/<app>/<id>/<name>) back to the host files they export, so that the
+    // dialog lists and stats the real folder instead of going through FUSE for every entry.
+    // Host paths are looked up with GetHostPaths (Info with older document portals) and
+    // cached per document id, failed lookups only briefly. Paths that don't resolve to an
+    // existing file are returned unchanged, paths outside the mount cost no D-Bus call.
+    // The mount point is queried when the resolver is created, again whenever the document
+    // portal appears on the bus, and by requests after a failed query; only a successful
+    // reply is kept. D-Bus calls are
+    // asynchronous, a request that needs an answer waits for it in a nested event loop.
+    class DocumentResolver : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static DocumentResolver &instance();
+
+        QString resolve(const QString &path);
+
+    private:
+        DocumentResolver();
+
+        void queryMountPoint();
+        void mountPointReplied(QDBusPendingCallWatcher *watcher);
+        void portalLost();
+        // whether path is below the known mount point or, while that is unknown, the default one
+        bool mayBeDocument(const QString &path) const;
+        bool ensureMountPoint();
+        QByteArray hostPath(const QString &docId);
+
+    private:
+        struct CacheEntry
+        {
+            QByteArray hostPath;
+            QDateTime expiry;
+        };
+
+        // empty while the document portal's mount point is unknown
+        QString m_mountPoint;
+        QPointer<QDBusPendingCallWatcher> m_mountPointCall;
+        // since the last failed mount point query
+        QElapsedTimer m_sinceFailure;
+        // document portals before version 5 only have Info
+        bool m_hasGetHostPaths = true;
+        // least recently used entries are evicted first
+        QCache<QString, CacheEntry> m_cache;
+        QDBusServiceWatcher m_serviceWatcher;
+    };
+}
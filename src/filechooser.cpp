@@ -28,81 +28,50 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "choices.h"
+#include "dialogsearch.h"
+#include "dialogworker.h"
+#include "documentresolver.h"
 #include "filechooser.h"
 #include "utils.h"
 #include "filedialoghelper.h"
-
+#include "fileuris.h"
+#include "filters.h"
+#include "folderpreloader.h"
+#include "parentwindow.h"
+#include "portalsettings.h"
+#include "portaltrace.h"
+#include "recentplace.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDBusArgument>
-#include <QDBusMetaType>
+#include <QDBusConnection>
+#include <QDBusMessage>
 #include <QDialogButtonBox>
+#include <QDir>
 #include <QFile>
+#include <QLabel>
 #include <QLayout>
 #include <QLoggingCategory>
-#include <QMimeDatabase>
+#include <QPointer>
 #include <QUrl>
 #include <QDBusObjectPath>
 #include <libfm-qt6/filedialog.h>
 
-// Keep in sync with qflatpakfiledialog from flatpak-platform-plugin
-Q_DECLARE_METATYPE(LXQt::FileChooserPortal::Filter)
-Q_DECLARE_METATYPE(LXQt::FileChooserPortal::Filters)
-Q_DECLARE_METATYPE(LXQt::FileChooserPortal::FilterList)
-Q_DECLARE_METATYPE(LXQt::FileChooserPortal::FilterListList)
-
 namespace LXQt
 {
     Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtFileChooser, "xdp-lxqt-file-chooser")
 
-
-    QDBusArgument &operator<<(QDBusArgument &arg, const FileChooserPortal::Filter &filter)
-    {
-        arg.beginStructure();
-        arg << filter.type << filter.filterString;
-        arg.endStructure();
-        return arg;
-    }
-
-    const QDBusArgument &operator>>(const QDBusArgument &arg, FileChooserPortal::Filter &filter)
-    {
-        uint type;
-        QString filterString;
-        arg.beginStructure();
-        arg >> type >> filterString;
-        filter.type = type;
-        filter.filterString = filterString;
-        arg.endStructure();
-
-        return arg;
-    }
-
-    QDBusArgument &operator<<(QDBusArgument &arg, const FileChooserPortal::FilterList &filterList)
-    {
-        arg.beginStructure();
-        arg << filterList.userVisibleName << filterList.filters;
-        arg.endStructure();
-        return arg;
-    }
-
-    const QDBusArgument &operator>>(const QDBusArgument &arg, FileChooserPortal::FilterList &filterList)
-    {
-        QString userVisibleName;
-        FileChooserPortal::Filters filters;
-        arg.beginStructure();
-        arg >> userVisibleName >> filters;
-        filterList.userVisibleName = userVisibleName;
-        filterList.filters = filters;
-        arg.endStructure();
-
-        return arg;
-    }
+    struct FileChooserPortal::Request {
+        QByteArray fingerprint;
+        QPointer<QWidget> dialog;
+        QList<QDBusMessage> duplicates;
+    };
 
     FileChooserPortal::FileChooserPortal(QObject *parent)
         : QDBusAbstractAdaptor(parent)
     {
-        qDBusRegisterMetaType<Filter>();
-        qDBusRegisterMetaType<Filters>();
-        qDBusRegisterMetaType<FilterList>();
-        qDBusRegisterMetaType<FilterListList>();
+        registerFilterMetaTypes();
         registerChoiceMetaTypes();
     }
 
@@ -119,28 +88,62 @@ namespace LXQt
         while (decodedName.endsWith('\0')) {
             decodedName.chop(1);
         }
-        QString str = QFile::decodeName(decodedName);
+        // sandboxed apps pass paths below the document portal's FUSE mount
+        QString str = DocumentResolver::instance().resolve(QFile::decodeName(decodedName));
         if (!str.isEmpty()) {
             return QUrl::fromLocalFile(str);
         }
         return QUrl();
     }
 
+    // Non-blocking notice for a requested folder that didn't respond in time
+    static void addUnreachableNotice(FileDialogHelper &fileDialog, const QString &folder, const QUrl &shown)
+    {
+        if (auto layout = fileDialog.dialog().layout()) {
+            const QString text = shown == QUrl::fromLocalFile(QDir::homePath())
+                ? FileChooserPortal::tr("The folder \"%1\" is not responding. Showing your home folder instead.").arg(folder)
+                : FileChooserPortal::tr("The folder \"%1\" is not responding, neither is your home folder. Showing \"%2\" instead.").arg(folder, shown.toLocalFile());
+            auto label = new QLabel(text);
+            label->setWordWrap(true);
+            layout->addWidget(label);
+        }
+    }
+
     uint FileChooserPortal::OpenFile(const QDBusObjectPath &handle,
             const QString &app_id,
             const QString &parent_window,
             const QString &title,
             const QVariantMap &options,
+            const QDBusMessage &message,
             QVariantMap &results)
     {
-        Q_UNUSED(app_id);
-
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "OpenFile called with parameters:";
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    handle: " << handle.path();
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    parent_window: " << parent_window;
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    title: " << title;
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    options: " << options;
 
+        if (auto recorder = TraceRecorder::instance()) {
+            recorder->record(QStringLiteral("OpenFile"), {app_id, parent_window, title}, options);
+        }
+
+        return deduplicate(QStringLiteral("OpenFile"), {app_id, parent_window, title}, options, message, results, [&](Request &request, QVariantMap &dialogResults) {
+            if (DialogWorkerPool::enabled()) {
+                // the dialog is in another process, duplicates can't raise it
+                return DialogWorkerPool::instance().run(this, QStringLiteral("OpenFile"), {app_id, parent_window, title}, options, dialogResults);
+            }
+            return openFileDialog(parent_window, title, options, request, dialogResults);
+        });
+    }
+
+    uint FileChooserPortal::openFileDialog(const QString &parent_window,
+            const QString &title,
+            const QVariantMap &options,
+            Request &request,
+            QVariantMap &results)
+    {
+        ParentWindow::prefetch(parent_window);
+
         bool directory = false;
         bool modalDialog = true;
         bool multipleFiles = false;
@@ -168,6 +171,11 @@ namespace LXQt
             currentFolder = decodeFileName(options.value(QStringLiteral("current_folder")).toByteArray());
         }
 
+        // don't let a folder on a hung mount block the dialog; it is probed, and listed once it
+        // responds, while the rest of the dialog is set up
+        FolderPreloader preloader;
+        preloader.start(currentFolder.isValid() ? currentFolder : mLastVisitedDirs.value(parent_window));
+
         ExtractFilters(options, nameFilters, allFilters, selectedNameFilter);
 
         // for handling of options - choices
@@ -181,19 +189,16 @@ namespace LXQt
             optionsWidget.reset(CreateChoiceControls(optionList, checkboxes, comboboxes));
         }
 
+        preloader.poll();
         auto fileDialog = FileDialogHelper::createFileDialogHelper();
-        Utils::setParentWindow(&fileDialog->dialog(), parent_window);
         fileDialog->setWindowTitle(title);
         fileDialog->setModal(modalDialog);
         fileDialog->setFileMode(directory ? QFileDialog::Directory : (multipleFiles ? QFileDialog::ExistingFiles : QFileDialog::ExistingFile));
         if (!acceptLabel.isEmpty())
             fileDialog->setLabelText(QFileDialog::Accept, acceptLabel);
 
-        if (currentFolder.isValid()) {
-            fileDialog->setDirectory(currentFolder);
-        } else if (mLastVisitedDirs.count(parent_window) > 0) {
-            fileDialog->setDirectory(mLastVisitedDirs[parent_window]);
-        }
+        const QUrl initialFolder = preloader.folder();
+        fileDialog->setDirectory(initialFolder);
 
         if (!nameFilters.isEmpty()) {
             fileDialog->setNameFilters(nameFilters);
@@ -208,16 +213,33 @@ namespace LXQt
             }
         }
 
+        if (!preloader.unreachableFolder().isEmpty()) {
+            addUnreachableNotice(*fileDialog, preloader.unreachableFolder(), initialFolder);
+        }
+
+        DialogSearch::attach(fileDialog->dialog(), directory ? FileSearch::Directories : FileSearch::Files);
+        if (!directory) {
+            RecentPlace::attach(fileDialog->dialog(), allFilters);
+        }
+
+        // the parent was validated while the dialog was built
+        Utils::setParentWindow(&fileDialog->dialog(), parent_window);
+        request.dialog = &fileDialog->dialog();
+
         if (fileDialog->execResult() == QDialog::Accepted) {
-            QStringList files;
-            for (const auto & url : fileDialog->selectedFiles()) {
-                files << url.toDisplayString();
-            }
+            qint64 urisSize = 0;
+            const QStringList files = FileUris::fromUrls(fileDialog->selectedFiles(), &urisSize);
 
             if (files.isEmpty()) {
                 qCDebug(XdgDesktopPortalLxqtFileChooser) << "Failed to open file: no local file selected";
                 return 2;
             }
+            // the bus would drop the reply and the app would only see the call time out
+            if (urisSize > FileUris::MaxMarshalledSize) {
+                qCWarning(XdgDesktopPortalLxqtFileChooser) << "Failed to open files:" << files.size() << "selected files need"
+                    << urisSize << "bytes, more than a D-Bus message can carry (" << FileUris::MaxMarshalledSize << ")";
+                return 2;
+            }
 
             results.insert(QStringLiteral("uris"), files);
             results.insert(QStringLiteral("writable"), true);
@@ -246,16 +268,36 @@ namespace LXQt
             const QString &parent_window,
             const QString &title,
             const QVariantMap &options,
+            const QDBusMessage &message,
             QVariantMap &results)
     {
-        Q_UNUSED(app_id);
-
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "SaveFile called with parameters:";
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    handle: " << handle.path();
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    parent_window: " << parent_window;
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    title: " << title;
         qCDebug(XdgDesktopPortalLxqtFileChooser) << "    options: " << options;
 
+        if (auto recorder = TraceRecorder::instance()) {
+            recorder->record(QStringLiteral("SaveFile"), {app_id, parent_window, title}, options);
+        }
+
+        return deduplicate(QStringLiteral("SaveFile"), {app_id, parent_window, title}, options, message, results, [&](Request &request, QVariantMap &dialogResults) {
+            if (DialogWorkerPool::enabled()) {
+                // the dialog is in another process, duplicates can't raise it
+                return DialogWorkerPool::instance().run(this, QStringLiteral("SaveFile"), {app_id, parent_window, title}, options, dialogResults);
+            }
+            return saveFileDialog(parent_window, title, options, request, dialogResults);
+        });
+    }
+
+    uint FileChooserPortal::saveFileDialog(const QString &parent_window,
+            const QString &title,
+            const QVariantMap &options,
+            Request &request,
+            QVariantMap &results)
+    {
+        ParentWindow::prefetch(parent_window);
+
         bool modalDialog = true;
         QString currentName;
         QUrl currentFolder;
@@ -283,6 +325,16 @@ namespace LXQt
             currentFile = decodeFileName(options.value(QStringLiteral("current_file")).toByteArray());
         }
 
+        // don't let a folder on a hung mount block the dialog; it is probed, and listed once it
+        // responds, while the rest of the dialog is set up. An existing file is shown in
+        // its own folder.
+        FolderPreloader preloader;
+        if (currentFile.isValid()) {
+            preloader.start(currentFile.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash));
+        } else {
+            preloader.start(currentFolder.isValid() ? currentFolder : mLastVisitedDirs.value(parent_window));
+        }
+
         ExtractFilters(options, nameFilters, allFilters, selectedNameFilter);
 
         // for handling of options - choices
@@ -296,8 +348,8 @@ namespace LXQt
             optionsWidget.reset(CreateChoiceControls(optionList, checkboxes, comboboxes));
         }
 
+        preloader.poll();
         auto fileDialog = FileDialogHelper::createFileDialogHelper();
-        Utils::setParentWindow(&fileDialog->dialog(), parent_window);
         fileDialog->setWindowTitle(title);
         fileDialog->setModal(modalDialog);
         fileDialog->setFileMode(QFileDialog::AnyFile);
@@ -305,11 +357,15 @@ namespace LXQt
         if (!acceptLabel.isEmpty())
             fileDialog->setLabelText(QFileDialog::Accept, acceptLabel);
 
-        if (currentFolder.isValid()) {
-            fileDialog->setDirectory(currentFolder);
-        } else if (mLastVisitedDirs.count(parent_window) > 0) {
-            fileDialog->setDirectory(mLastVisitedDirs[parent_window]);
+        const QUrl initialFolder = preloader.folder();
+        if (!preloader.unreachableFolder().isEmpty() && currentFile.isValid()) {
+            // keep suggesting the file name, but in the fallback folder
+            if (currentName.isEmpty()) {
+                currentName = currentFile.fileName();
+            }
+            currentFile.clear();
         }
+        fileDialog->setDirectory(initialFolder);
 
         if (currentFile.isValid()) {
             fileDialog->selectFile(currentFile);
@@ -341,12 +397,16 @@ namespace LXQt
             }
         }
 
+        if (!preloader.unreachableFolder().isEmpty()) {
+            addUnreachableNotice(*fileDialog, preloader.unreachableFolder(), initialFolder);
+        }
+
+        // the parent was validated while the dialog was built
+        Utils::setParentWindow(&fileDialog->dialog(), parent_window);
+        request.dialog = &fileDialog->dialog();
+
         if (fileDialog->execResult() == QDialog::Accepted) {
-            QStringList files;
-            for (const auto & url : fileDialog->selectedFiles()) {
-                files << url.toDisplayString();
-                break;
-            }
+            const QStringList files = FileUris::fromUrls(fileDialog->selectedFiles().mid(0, 1));
             results.insert(QStringLiteral("uris"), files);
 
             if (bHasOptions) {
@@ -368,79 +428,118 @@ namespace LXQt
         return 1;
     }
 
-    QString FileChooserPortal::ExtractAcceptLabel(const QVariantMap &options)
+    // answers a call that was attached to another call's dialog
+    static void replyToDuplicate(const QDBusMessage &message, uint response, const QVariantMap &results)
     {
-        QString acceptLabel;
-        if (options.contains(QStringLiteral("accept_label"))) {
-            acceptLabel = options.value(QStringLiteral("accept_label")).toString();
-            Utils::convertGtkMnemonic(acceptLabel);
-        }
-        return acceptLabel;
+        QDBusConnection::sessionBus().send(message.createReply(QVariantList{response, results}));
     }
 
-    void FileChooserPortal::ExtractFilters(const QVariantMap &options,
-            QStringList &nameFilters,
-            QMap<QString, FilterList> &allFilters,
-            QString &selectedNameFilter)
+    static void streamFilterList(QDataStream &stream, const FilterList &filterList)
     {
-        if (options.contains(QStringLiteral("filters"))) {
-            const FilterListList filterListList = qdbus_cast<FilterListList>(options.value(QStringLiteral("filters")));
-            for (const FilterList &filterList : filterListList) {
-                QStringList filterStrings;
-                for (const Filter &filterStruct : filterList.filters) {
-                    if (filterStruct.type == 0) {
-                        filterStrings << filterStruct.filterString;
-                    } else {
-                        filterStrings << NameFiltersForMimeType(filterStruct.filterString);
-                    }
-                }
+        stream << filterList.userVisibleName << static_cast<quint32>(filterList.filters.size());
+        for (const Filter &filter : filterList.filters) {
+            stream << filter.type << filter.filterString;
+        }
+    }
 
-                if (!filterStrings.isEmpty()) {
-                    const QString filterString = filterStrings.join(QLatin1Char(' '));
-                    const QString nameFilter = QStringLiteral("%2 (%1)").arg(filterString, filterList.userVisibleName);
-                    nameFilters << nameFilter;
-                    allFilters[nameFilter] = filterList;
-                }
-            }
+    // Hashes the fields that shape the dialog; the handle differs between retries,
+    // everything else has to match
+    static QByteArray requestFingerprint(const QString &method, const QStringList &arguments, const QVariantMap &options)
+    {
+        QByteArray payload;
+        QDataStream stream{&payload, QIODevice::WriteOnly};
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << method << arguments;
+
+        static const QStringList plainOptions{QStringLiteral("modal"),
+                                              QStringLiteral("multiple"),
+                                              QStringLiteral("directory"),
+                                              QStringLiteral("accept_label"),
+                                              QStringLiteral("current_name"),
+                                              QStringLiteral("current_folder"),
+                                              QStringLiteral("current_file")};
+        for (const QString &key : plainOptions) {
+            stream << options.value(key);
         }
 
+        const FilterListList filterLists = qdbus_cast<FilterListList>(options.value(QStringLiteral("filters")));
+        stream << static_cast<quint32>(filterLists.size());
+        for (const FilterList &filterList : filterLists) {
+            streamFilterList(stream, filterList);
+        }
+        stream << options.contains(QStringLiteral("current_filter"));
         if (options.contains(QStringLiteral("current_filter"))) {
-            FilterList filterList = qdbus_cast<FilterList>(options.value(QStringLiteral("current_filter")));
-            if (filterList.filters.size() == 1) {
-                QStringList filterStrings;
-                Filter filterStruct = filterList.filters.at(0);
-                if (filterStruct.type == 0) {
-                    filterStrings << filterStruct.filterString;
-                } else {
-                    filterStrings << NameFiltersForMimeType(filterStruct.filterString);
-                }
+            streamFilterList(stream, qdbus_cast<FilterList>(options.value(QStringLiteral("current_filter"))));
+        }
 
-                if (!filterStrings.isEmpty()) {
-                    // make the relevant entry the first one in the list of filters,
-                    // since that is the one that gets preselected by KFileWidget::setFilter
-                    const QString filterString = filterStrings.join(QLatin1Char(' '));
-                    const QString nameFilter = QStringLiteral("%2 (%1)").arg(filterString, filterList.userVisibleName);
-                    nameFilters.removeAll(nameFilter);
-                    nameFilters.push_front(nameFilter);
-                    selectedNameFilter = nameFilter;
-                }
-            } else {
-                qCDebug(XdgDesktopPortalLxqtFileChooser) << "Ignoring 'current_filter' parameter with 0 or multiple filters specified.";
+        const OptionList optionList = qdbus_cast<OptionList>(options.value(QStringLiteral("choices")));
+        stream << static_cast<quint32>(optionList.size());
+        for (const Option &option : optionList) {
+            stream << option.id << option.label << option.initialChoiceId << static_cast<quint32>(option.choices.size());
+            for (const Choice &choice : option.choices) {
+                stream << choice.id << choice.value;
             }
         }
+        return QCryptographicHash::hash(payload, QCryptographicHash::Sha1);
     }
 
-    QStringList FileChooserPortal::NameFiltersForMimeType(const QString &mimeType)
+    uint FileChooserPortal::deduplicate(const QString &method,
+            const QStringList &arguments,
+            const QVariantMap &options,
+            const QDBusMessage &message,
+            QVariantMap &results,
+            const std::function<uint(Request &, QVariantMap &)> &showDialog)
     {
-        QMimeDatabase db;
-        QMimeType mime(db.mimeTypeForName(mimeType));
+        const QByteArray fingerprint = requestFingerprint(method, arguments, options);
+        const QList<Request *> &requests = mRequests;
+        for (Request *request : requests) {
+            if (request->fingerprint == fingerprint) {
+                qCDebug(XdgDesktopPortalLxqtFileChooser) << method << "from" << arguments.value(0) << "attached to the dialog already open";
+                if (request->dialog) {
+                    request->dialog->raise();
+                    request->dialog->activateWindow();
+                }
+                message.setDelayedReply(true);
+                request->duplicates.append(message);
+                // not sent, the reply goes out when the dialog closes
+                return 2;
+            }
+        }
+
+        Request request{fingerprint, nullptr, {}};
+        mRequests.append(&request);
+        const uint response = showDialog(request, results);
+        mRequests.removeOne(&request);
 
-        if (mime.isValid()) {
-            if (mime.isDefault()) {
-                return QStringList("*");
+        if (request.duplicates.isEmpty()) {
+            return response;
+        }
+        if (PortalSettings::instance().duplicateRequests() == PortalSettings::CancelEarlier) {
+            // only the latest call gets the result, even the one that opened the dialog
+            // (and whose dialog the user worked in) is cancelled
+            const QDBusMessage latest = request.duplicates.takeLast();
+            const QList<QDBusMessage> &earlier = request.duplicates;
+            for (const QDBusMessage &duplicate : earlier) {
+                replyToDuplicate(duplicate, 1, {});
             }
-            return mime.globPatterns();
+            replyToDuplicate(latest, response, results);
+            results.clear();
+            return 1;
+        }
+        const QList<QDBusMessage> &duplicates = request.duplicates;
+        for (const QDBusMessage &duplicate : duplicates) {
+            replyToDuplicate(duplicate, response, results);
+        }
+        return response;
+    }
+
+    QString FileChooserPortal::ExtractAcceptLabel(const QVariantMap &options)
+    {
+        QString acceptLabel;
+        if (options.contains(QStringLiteral("accept_label"))) {
+            acceptLabel = options.value(QStringLiteral("accept_label")).toString();
+            Utils::convertGtkMnemonic(acceptLabel);
         }
-        return QStringList();
+        return acceptLabel;
     }
 }
@@ -30,8 +30,15 @@
 #pragma once
 
 #include <QDBusAbstractAdaptor>
+#include <QList>
+#include <QMap>
+#include <QUrl>
 
+#include <functional>
+
+class QDBusMessage;
 class QDBusObjectPath;
+class QWidget;
 
 namespace LXQt
 {
@@ -40,28 +47,20 @@ namespace LXQt
         Q_OBJECT
         Q_CLASSINFO("D-Bus Interface", "org.freedesktop.impl.portal.FileChooser")
     public:
-        // Keep in sync with qflatpakfiledialog from flatpak-platform-plugin
-        struct Filter {
-            uint type;
-            QString filterString;
-        };
-        using Filters = QList<Filter>;
-
-        struct FilterList {
-            QString userVisibleName;
-            Filters filters;
-        };
-        using FilterListList = QList<FilterList>;
-
         explicit FileChooserPortal(QObject *parent);
         ~FileChooserPortal();
 
+        // the folder the last dialog for parent_window ended in, carried across dialog workers
+        QUrl lastVisitedDir(const QString &parent_window) const { return mLastVisitedDirs.value(parent_window); }
+        void setLastVisitedDir(const QString &parent_window, const QUrl &dir) { mLastVisitedDirs[parent_window] = dir; }
+
     public Q_SLOTS:
         uint OpenFile(const QDBusObjectPath &handle,
                 const QString &app_id,
                 const QString &parent_window,
                 const QString &title,
                 const QVariantMap &options,
+                const QDBusMessage &message,
                 QVariantMap &results);
 
         uint SaveFile(const QDBusObjectPath &handle,
@@ -69,19 +68,39 @@ namespace LXQt
                 const QString &parent_window,
                 const QString &title,
                 const QVariantMap &options,
+                const QDBusMessage &message,
                 QVariantMap &results);
 
     private:
-        static QString ExtractAcceptLabel(const QVariantMap &options);
+        // A call with the same app, parent, title and options as one whose dialog is still
+        // open is attached to that dialog, which is raised, instead of getting its own. When
+        // the dialog closes the attached calls get its result, or, with
+        // DuplicateRequests=cancel-earlier, only the latest call does and the others,
+        // including the one that opened the dialog, are cancelled.
+        struct Request;
+        uint deduplicate(const QString &method,
+                const QStringList &arguments,
+                const QVariantMap &options,
+                const QDBusMessage &message,
+                QVariantMap &results,
+                const std::function<uint(Request &, QVariantMap &)> &showDialog);
 
-        static void ExtractFilters(const QVariantMap &options,
-                QStringList &nameFilters,
-                QMap<QString, FilterList> &allFilters,
-                QString &selectedNameFilter);
+        // request gets the dialog, so that duplicates of it can raise the dialog
+        uint openFileDialog(const QString &parent_window,
+                const QString &title,
+                const QVariantMap &options,
+                Request &request,
+                QVariantMap &results);
+        uint saveFileDialog(const QString &parent_window,
+                const QString &title,
+                const QVariantMap &options,
+                Request &request,
+                QVariantMap &results);
 
-        static QStringList NameFiltersForMimeType(const QString &mimeType);
+        static QString ExtractAcceptLabel(const QVariantMap &options);
 
     private:
         QMap<QString, QUrl> mLastVisitedDirs;
+        QList<Request *> mRequests;
     };
 }
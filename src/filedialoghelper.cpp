@@ -26,13 +26,17 @@
  * END_COMMON_COPYRIGHT_HEADER */
 
 #include "filedialoghelper.h"
+#include "folderviewtuner.h"
+#include "lazyplaces.h"
+#include "thumbnailpool.h"
+#include "utils.h"
 #include <libfm-qt6/libfmqt.h>
 #include <QCoreApplication>
 #include <QWindow>
 
 namespace LXQt
 {
-    /*static*/ std::unique_ptr<FileDialogHelper> FileDialogHelper::createFileDialogHelper()
+    /*static*/ void FileDialogHelper::initLibFmQt()
     {
         static std::unique_ptr<Fm::LibFmQt> libfmQtContext_;
         if(!libfmQtContext_) {
@@ -40,15 +44,24 @@ namespace LXQt
             libfmQtContext_ = std::unique_ptr<Fm::LibFmQt>{new Fm::LibFmQt()};
             // add translations
             QCoreApplication::installTranslator(libfmQtContext_.get()->translator());
+            configureThumbnailPool();
         }
+    }
+
+    /*static*/ std::unique_ptr<FileDialogHelper> FileDialogHelper::createFileDialogHelper()
+    {
+        initLibFmQt();
         auto d = std::unique_ptr<FileDialogHelper>{new FileDialogHelper{}};
         d->setOptions(QFileDialogOptions::create());
+        FolderViewTuner::attach(d->dialog());
+        LazyPlaces::attach(d->dialog());
         return d;
     }
 
     int FileDialogHelper::execResult()
     {
         show(dialog().windowFlags(), dialog().windowModality(), dialog().windowHandle() ? dialog().windowHandle()->transientParent() : nullptr);
+        Utils::scheduleAutoResponse(&dialog());
         Fm::FileDialogHelper::exec();
         return dialog().result();
     }
@@ -41,6 +41,8 @@ namespace LXQt
     {
     public:
         static std::unique_ptr<FileDialogHelper> createFileDialogHelper();
+        // initializes libfm-qt once; needed before any Fm:: core object is created
+        static void initLibFmQt();
 
     private:
         FileDialogHelper() = default;
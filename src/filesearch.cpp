@@ -0,0 +1,312 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "filesearch.h"
+#include "direnumerator.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtSearch, "xdp-lxqt-search")
+
+    // results are handed to the view at most this often
+    static constexpr int DeliveryInterval = 100;
+
+    struct FileSearch::Run
+    {
+        struct Folder
+        {
+            QByteArray path;
+            int depth;
+        };
+
+        struct Walker
+        {
+            std::mutex mutex;
+            // own work is taken from the back (depth first), stolen work from the front
+            std::deque<Folder> queue;
+        };
+
+        QString query;
+        QList<QRegularExpression> patterns;
+        Target target;
+        Limits limits;
+        dev_t device = 0;
+        QElapsedTimer clock;
+
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> truncated{false};
+        // folders queued or being read; the walk is over when it drops to zero
+        std::atomic<int> pending{0};
+        std::atomic<int> folders{0};
+        std::atomic<int> matches{0};
+        std::atomic<int> activeWalkers{0};
+        std::vector<std::unique_ptr<Walker>> walkers;
+
+        std::mutex resultsMutex;
+        QStringList results;
+
+        bool stopRequested()
+        {
+            if (cancelled.load(std::memory_order_relaxed)) {
+                return true;
+            }
+            if (clock.hasExpired(limits.timeoutMs)) {
+                truncated = true;
+                cancelled = true;
+                return true;
+            }
+            return false;
+        }
+
+        void push(int walker, Folder folder)
+        {
+            ++pending;
+            std::lock_guard<std::mutex> lock{walkers[walker]->mutex};
+            walkers[walker]->queue.push_back(std::move(folder));
+        }
+
+        bool take(int walker, Folder &folder)
+        {
+            {
+                Walker &own = *walkers[walker];
+                std::lock_guard<std::mutex> lock{own.mutex};
+                if (!own.queue.empty()) {
+                    folder = std::move(own.queue.back());
+                    own.queue.pop_back();
+                    return true;
+                }
+            }
+            for (size_t i = 1; i < walkers.size(); ++i) {
+                Walker &victim = *walkers[(walker + i) % walkers.size()];
+                std::lock_guard<std::mutex> lock{victim.mutex};
+                if (!victim.queue.empty()) {
+                    folder = std::move(victim.queue.front());
+                    victim.queue.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool isMatch(const QString &name, bool isDirectory) const
+        {
+            if ((target == Directories) != isDirectory || !name.contains(query, Qt::CaseInsensitive)) {
+                return false;
+            }
+            if (isDirectory || patterns.isEmpty()) {
+                return true;
+            }
+            for (const auto &pattern : patterns) {
+                if (pattern.match(name).hasMatch()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void walkFolder(int walker, const Folder &folder)
+        {
+            const int fd = DirEnumerator::open(folder.path);
+            if (fd < 0) {
+                return;
+            }
+            struct stat st;
+            // like find -xdev: other filesystems may be slow or huge (network mounts, /proc)
+            if (::fstat(fd, &st) != 0 || st.st_dev != device) {
+                ::close(fd);
+                return;
+            }
+            if (++folders > limits.maxFolders) {
+                truncated = true;
+                cancelled = true;
+                ::close(fd);
+                return;
+            }
+
+            const bool showHidden = query.startsWith(QLatin1Char('.'));
+            const QByteArray prefix = folder.path.endsWith('/') ? folder.path : folder.path + '/';
+            const QString displayPrefix = QFile::decodeName(prefix);
+            QStringList found;
+            // folder searches skip regular files on d_type alone, without a syscall or a name conversion
+            const DirEnumerator::Mode mode = target == Directories ? DirEnumerator::DirectoriesOnly : DirEnumerator::AllEntries;
+            DirEnumerator::enumerate(fd, mode, [&](const DirEnumerator::Entry &entry) {
+                if (stopRequested()) {
+                    return false;
+                }
+                const bool hidden = entry.name[0] == '.';
+                if (hidden && !showHidden) {
+                    return true;
+                }
+                const QString name = QString::fromUtf8(entry.name, entry.nameLength);
+                if (isMatch(name, entry.isDirectory)) {
+                    // the walk goes on at the limit, only a match that doesn't fit makes the list incomplete
+                    if (++matches > limits.maxResults) {
+                        truncated = true;
+                        cancelled = true;
+                        return false;
+                    }
+                    found << displayPrefix + name;
+                }
+                if (entry.isDirectory && !entry.isSymlink && !hidden && folder.depth < limits.maxDepth) {
+                    push(walker, Folder{prefix + QByteArray{entry.name, entry.nameLength}, folder.depth + 1});
+                }
+                return true;
+            });
+            ::close(fd);
+
+            if (!found.isEmpty()) {
+                std::lock_guard<std::mutex> lock{resultsMutex};
+                results << found;
+            }
+        }
+
+        void walk(int walker)
+        {
+            Folder folder;
+            while (!cancelled.load(std::memory_order_relaxed)) {
+                if (!take(walker, folder)) {
+                    if (pending.load() == 0) {
+                        break;
+                    }
+                    // someone is still reading a folder and may push more work
+                    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                    continue;
+                }
+                walkFolder(walker, folder);
+                --pending;
+            }
+            --activeWalkers;
+        }
+    };
+
+    FileSearch::FileSearch(QObject *parent)
+        : QObject{parent}
+    {
+        m_deliveryTimer.setInterval(DeliveryInterval);
+        connect(&m_deliveryTimer, &QTimer::timeout, this, &FileSearch::deliver);
+    }
+
+    FileSearch::~FileSearch()
+    {
+        cancel();
+    }
+
+    void FileSearch::start(const QString &root, const QString &query, const QStringList &patterns, Target target, const Limits &limits)
+    {
+        cancel();
+
+        const QByteArray rootPath = QFile::encodeName(root);
+        struct stat st;
+        if (query.isEmpty() || ::stat(rootPath.constData(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+            Q_EMIT finished(true);
+            return;
+        }
+
+        auto run = std::make_shared<Run>();
+        run->query = query;
+        for (const QString &pattern : patterns) {
+            if (pattern != QLatin1String("*")) {
+                run->patterns << QRegularExpression{QRegularExpression::wildcardToRegularExpression(pattern), QRegularExpression::CaseInsensitiveOption};
+            }
+        }
+        run->target = target;
+        run->limits = limits;
+        run->device = st.st_dev;
+        const int threads = limits.threads > 0 ? limits.threads : qBound(2, QThread::idealThreadCount(), 8);
+        for (int i = 0; i < threads; ++i) {
+            run->walkers.emplace_back(new Run::Walker);
+        }
+        run->push(0, Run::Folder{rootPath, 0});
+        run->activeWalkers = threads;
+        run->clock.start();
+
+        // the threads own the run with us, a cancelled walk is left to finish on its own
+        for (int i = 0; i < threads; ++i) {
+            std::thread{[run, i] { run->walk(i); }}.detach();
+        }
+        m_run = run;
+        m_deliveryTimer.start();
+        qCDebug(XdgDesktopPortalLxqtSearch) << "Searching" << root << "for" << query << patterns << "with" << threads << "walkers";
+    }
+
+    void FileSearch::cancel()
+    {
+        if (m_run) {
+            m_run->cancelled = true;
+            m_run.reset();
+        }
+        m_deliveryTimer.stop();
+    }
+
+    void FileSearch::deliver()
+    {
+        if (!m_run) {
+            return;
+        }
+        const std::shared_ptr<Run> run = m_run;
+        const bool done = run->activeWalkers.load() == 0;
+        QStringList results;
+        {
+            std::lock_guard<std::mutex> lock{run->resultsMutex};
+            results.swap(run->results);
+        }
+        if (!results.isEmpty()) {
+            Q_EMIT resultsFound(results);
+        }
+        // the slot may have cancelled this search or started another one
+        if (done && m_run == run) {
+            const bool complete = !run->truncated;
+            qCDebug(XdgDesktopPortalLxqtSearch) << "Search finished after" << run->clock.elapsed() << "ms," << run->folders.load() << "folders,"
+                                                << qMin(run->matches.load(), run->limits.maxResults) << "matches";
+            m_run.reset();
+            m_deliveryTimer.stop();
+            Q_EMIT finished(complete);
+        }
+    }
+
+    /*static*/ QStringList FileSearch::patternsFromNameFilter(const QString &nameFilter)
+    {
+        // same format as QPlatformFileDialogHelper::cleanFilterList()
+        static const QRegularExpression filterRegExp{QStringLiteral("^(.*)\\(([a-zA-Z0-9_.,*? +;#\\-\\[\\]@\\{\\}/!<>\\$%&=^~:\\|]*)\\)$")};
+        const QRegularExpressionMatch match = filterRegExp.match(nameFilter.trimmed());
+        const QString patterns = match.hasMatch() ? match.captured(2) : nameFilter;
+        return patterns.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    }
+}
@@ -0,0 +1,94 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QObject>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTimer>
+
+#include <memory>
+
+namespace LXQt
+{
+    // Recursive name search below a folder. The tree is walked by a few threads, each with
+    // its own queue of folders; an idle walker steals the oldest (shallowest, so usually the
+    // largest) pending folder of another one. Matches are collected by the walkers and
+    // handed out in batches on the thread that owns the FileSearch, so a view can append
+    // them as they arrive. Walkers stay on the root's filesystem and skip hidden folders.
+    class FileSearch : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        struct Limits
+        {
+            int maxDepth = 16;
+            int maxResults = 2000;
+            // folders visited, bounds the work on trees with few matches
+            int maxFolders = 200000;
+            int timeoutMs = 15000;
+            // 0 picks a small number based on the CPU count
+            int threads = 0;
+        };
+
+        enum Target {
+            Files,
+            Directories
+        };
+
+        explicit FileSearch(QObject *parent = nullptr);
+        ~FileSearch() override;
+
+        // Cancels a running search and starts a new one. Names containing query (case
+        // insensitive) and, for files, matching one of the wildcard patterns are reported.
+        void start(const QString &root, const QString &query, const QStringList &patterns, Target target, const Limits &limits);
+        void start(const QString &root, const QString &query, const QStringList &patterns, Target target = Files) { start(root, query, patterns, target, Limits{}); }
+
+        // Walkers notice within one directory entry and no further results are delivered.
+        // Nothing waits for them, a walker blocked in a hung mount just finishes later.
+        void cancel();
+
+        bool isRunning() const { return m_run != nullptr; }
+
+        // "Images (*.png *.jpg)" -> {"*.png", "*.jpg"}
+        static QStringList patternsFromNameFilter(const QString &nameFilter);
+
+    Q_SIGNALS:
+        void resultsFound(const QStringList &paths);
+        // complete is false if a limit stopped the walk
+        void finished(bool complete);
+
+    private:
+        struct Run;
+
+        void deliver();
+
+    private:
+        std::shared_ptr<Run> m_run;
+        QTimer m_deliveryTimer;
+    };
+}
@@ -0,0 +1,105 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "fileuris.h"
+
+#include <QFile>
+
+namespace LXQt
+{
+    namespace
+    {
+        // unreserved characters, sub-delims, ':', '@' and the path separator are kept as is
+        struct KeepTable
+        {
+            bool keep[256] = {};
+
+            KeepTable()
+            {
+                for (int c = 'a'; c <= 'z'; ++c) {
+                    keep[c] = true;
+                }
+                for (int c = 'A'; c <= 'Z'; ++c) {
+                    keep[c] = true;
+                }
+                for (int c = '0'; c <= '9'; ++c) {
+                    keep[c] = true;
+                }
+                for (const char c : QByteArrayLiteral("-._~!$&'()*+,;=:@/")) {
+                    keep[static_cast<unsigned char>(c)] = true;
+                }
+            }
+        };
+
+        // string in a D-Bus message: 4 byte aligned length, the UTF-8 data and a NUL
+        qint64 marshalledStringSize(const QString &string)
+        {
+            const qint64 size = 4 + string.size() + 1;
+            return (size + 3) & ~qint64(3);
+        }
+    }
+
+    /*static*/ QString FileUris::fromLocalPath(const QByteArray &path, QByteArray &buffer)
+    {
+        static const KeepTable table;
+        static const char hex[] = "0123456789ABCDEF";
+
+        static const char prefix[] = "file://";
+        buffer.resize(int(sizeof(prefix) - 1) + path.size() * 3);
+        char *out = buffer.data();
+        for (const char *p = prefix; *p; ++p) {
+            *out++ = *p;
+        }
+        for (const char c : path) {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            if (table.keep[byte]) {
+                *out++ = c;
+            } else {
+                *out++ = '%';
+                *out++ = hex[byte >> 4];
+                *out++ = hex[byte & 0xf];
+            }
+        }
+        // the result is ASCII only
+        return QString::fromLatin1(buffer.constData(), int(out - buffer.constData()));
+    }
+
+    /*static*/ QStringList FileUris::fromUrls(const QList<QUrl> &urls, qint64 *marshalledSize)
+    {
+        QStringList uris;
+        uris.reserve(urls.size());
+        QByteArray buffer;
+        qint64 size = 0;
+        for (const QUrl &url : urls) {
+            QString uri = url.isLocalFile() ? fromLocalPath(QFile::encodeName(url.toLocalFile()), buffer) : url.toString(QUrl::FullyEncoded);
+            size += marshalledStringSize(uri);
+            uris.append(std::move(uri));
+        }
+        if (marshalledSize) {
+            *marshalledSize = size;
+        }
+        return uris;
+    }
+}
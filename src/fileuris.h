@@ -0,0 +1,50 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QList>
+#include <QStringList>
+#include <QUrl>
+
+namespace LXQt
+{
+    // Builds the "uris" result of the FileChooser methods. Local files, which is nearly
+    // every selection, are percent-encoded straight from their path into a reused buffer
+    // instead of going through QUrl's parser and formatter per file.
+    class FileUris
+    {
+    public:
+        // dbus-daemon rejects arrays over 64 MiB (DBUS_MAXIMUM_ARRAY_LENGTH); leave room
+        // for the rest of the reply, the whole message is limited to 128 MiB
+        static constexpr qint64 MaxMarshalledSize = 64 * 1024 * 1024 - 64 * 1024;
+
+        // marshalledSize receives the size of the resulting "as" array in a D-Bus message
+        static QStringList fromUrls(const QList<QUrl> &urls, qint64 *marshalledSize = nullptr);
+
+        // "file://" followed by path, percent-encoded like g_filename_to_uri() does
+        static QString fromLocalPath(const QByteArray &path, QByteArray &buffer);
+    };
+}
@@ -0,0 +1,157 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2016-2018 Red Hat Inc
+ * Copyright: 2016-2018 Jan Grulich <jgrulich@redhat.com>
+ * Copyright: 2021~ LXQt team
+ * Authors:
+ *   Palo Kisa <palo.kisa@gmail.com>
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "filters.h"
+
+#include <QDBusArgument>
+#include <QDBusMetaType>
+#include <QLoggingCategory>
+#include <QMimeDatabase>
+
+namespace LXQt
+{
+    // the messages predate this file, keep their category for existing QT_LOGGING_RULES
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtFilters, "xdp-lxqt-file-chooser")
+
+    QDBusArgument &operator<<(QDBusArgument &arg, const Filter &filter)
+    {
+        arg.beginStructure();
+        arg << filter.type << filter.filterString;
+        arg.endStructure();
+        return arg;
+    }
+
+    const QDBusArgument &operator>>(const QDBusArgument &arg, Filter &filter)
+    {
+        uint type;
+        QString filterString;
+        arg.beginStructure();
+        arg >> type >> filterString;
+        filter.type = type;
+        filter.filterString = filterString;
+        arg.endStructure();
+
+        return arg;
+    }
+
+    QDBusArgument &operator<<(QDBusArgument &arg, const FilterList &filterList)
+    {
+        arg.beginStructure();
+        arg << filterList.userVisibleName << filterList.filters;
+        arg.endStructure();
+        return arg;
+    }
+
+    const QDBusArgument &operator>>(const QDBusArgument &arg, FilterList &filterList)
+    {
+        QString userVisibleName;
+        Filters filters;
+        arg.beginStructure();
+        arg >> userVisibleName >> filters;
+        filterList.userVisibleName = userVisibleName;
+        filterList.filters = filters;
+        arg.endStructure();
+
+        return arg;
+    }
+
+    void registerFilterMetaTypes()
+    {
+        qDBusRegisterMetaType<Filter>();
+        qDBusRegisterMetaType<Filters>();
+        qDBusRegisterMetaType<FilterList>();
+        qDBusRegisterMetaType<FilterListList>();
+    }
+
+    void ExtractFilters(const QVariantMap &options,
+            QStringList &nameFilters,
+            QMap<QString, FilterList> &allFilters,
+            QString &selectedNameFilter)
+    {
+        if (options.contains(QStringLiteral("filters"))) {
+            const FilterListList filterListList = qdbus_cast<FilterListList>(options.value(QStringLiteral("filters")));
+            for (const FilterList &filterList : filterListList) {
+                QStringList filterStrings;
+                for (const Filter &filterStruct : filterList.filters) {
+                    if (filterStruct.type == 0) {
+                        filterStrings << filterStruct.filterString;
+                    } else {
+                        filterStrings << NameFiltersForMimeType(filterStruct.filterString);
+                    }
+                }
+
+                if (!filterStrings.isEmpty()) {
+                    const QString filterString = filterStrings.join(QLatin1Char(' '));
+                    const QString nameFilter = QStringLiteral("%2 (%1)").arg(filterString, filterList.userVisibleName);
+                    nameFilters << nameFilter;
+                    allFilters[nameFilter] = filterList;
+                }
+            }
+        }
+
+        if (options.contains(QStringLiteral("current_filter"))) {
+            FilterList filterList = qdbus_cast<FilterList>(options.value(QStringLiteral("current_filter")));
+            if (filterList.filters.size() == 1) {
+                QStringList filterStrings;
+                Filter filterStruct = filterList.filters.at(0);
+                if (filterStruct.type == 0) {
+                    filterStrings << filterStruct.filterString;
+                } else {
+                    filterStrings << NameFiltersForMimeType(filterStruct.filterString);
+                }
+
+                if (!filterStrings.isEmpty()) {
+                    // make the relevant entry the first one in the list of filters,
+                    // since that is the one that gets preselected by KFileWidget::setFilter
+                    const QString filterString = filterStrings.join(QLatin1Char(' '));
+                    const QString nameFilter = QStringLiteral("%2 (%1)").arg(filterString, filterList.userVisibleName);
+                    nameFilters.removeAll(nameFilter);
+                    nameFilters.push_front(nameFilter);
+                    selectedNameFilter = nameFilter;
+                }
+            } else {
+                qCDebug(XdgDesktopPortalLxqtFilters) << "Ignoring 'current_filter' parameter with 0 or multiple filters specified.";
+            }
+        }
+    }
+
+    QStringList NameFiltersForMimeType(const QString &mimeType)
+    {
+        QMimeDatabase db;
+        QMimeType mime(db.mimeTypeForName(mimeType));
+
+        if (mime.isValid()) {
+            if (mime.isDefault()) {
+                return QStringList("*");
+            }
+            return mime.globPatterns();
+        }
+        return QStringList();
+    }
+}
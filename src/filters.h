@@ -0,0 +1,75 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2016-2018 Red Hat Inc
+ * Copyright: 2016-2018 Jan Grulich <jgrulich@redhat.com>
+ * Copyright: 2021~ LXQt team
+ * Authors:
+ *   Palo Kisa <palo.kisa@gmail.com>
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class QDBusArgument;
+
+namespace LXQt
+{
+    // Keep in sync with qflatpakfiledialog from flatpak-platform-plugin
+    struct Filter {
+        uint type;
+        QString filterString;
+    };
+    using Filters = QList<Filter>;
+
+    struct FilterList {
+        QString userVisibleName;
+        Filters filters;
+    };
+    using FilterListList = QList<FilterList>;
+
+    QDBusArgument &operator<<(QDBusArgument &arg, const Filter &filter);
+    const QDBusArgument &operator>>(const QDBusArgument &arg, Filter &filter);
+    QDBusArgument &operator<<(QDBusArgument &arg, const FilterList &filterList);
+    const QDBusArgument &operator>>(const QDBusArgument &arg, FilterList &filterList);
+
+    void registerFilterMetaTypes();
+
+    // Converts the "filters" and "current_filter" options into name filters for the dialog;
+    // allFilters maps each name filter back to the filter list it was created from.
+    void ExtractFilters(const QVariantMap &options,
+            QStringList &nameFilters,
+            QMap<QString, FilterList> &allFilters,
+            QString &selectedNameFilter);
+
+    QStringList NameFiltersForMimeType(const QString &mimeType);
+}
+
+Q_DECLARE_METATYPE(LXQt::Filter)
+Q_DECLARE_METATYPE(LXQt::Filters)
+Q_DECLARE_METATYPE(LXQt::FilterList)
+Q_DECLARE_METATYPE(LXQt::FilterListList)
@@ -0,0 +1,162 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "foldercache.h"
+#include "mounttable.h"
+#include "portalsettings.h"
+
+#include <QLoggingCategory>
+
+#include <libfm-qt6/core/folder.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtFolderCache, "xdp-lxqt-foldercache")
+
+    // bound on the number of held folders, each one costs two inotify watches
+    static constexpr int MaxEntries = 64;
+    // rough footprint of a FileInfo with its name, MIME type and icon references
+    static constexpr qint64 CostPerFile = 512;
+
+    // Decided from /proc/self/mountinfo; statfs() on the folder would block the GUI
+    // thread on a dead NFS server.
+    static bool isCacheableFilesystem(const QString &path)
+    {
+        const QList<MountEntry> mounts = MountTable::read();
+        const MountEntry *mount = MountTable::topmost(MountTable::mountPointOf(path, mounts), mounts);
+        if (mount == nullptr) {
+            return false;
+        }
+        // network and FUSE filesystems (sshfs, gvfsd-fuse, document portal, ...) have no
+        // reliable change notification, and listing them is what should be avoided
+        return !mount->isRemote() && !mount->fsType.startsWith(QLatin1String("fuse"))
+            && mount->fsType != QLatin1String("coda");
+    }
+
+    /*static*/ FolderCache &FolderCache::instance()
+    {
+        static FolderCache cache;
+        return cache;
+    }
+
+    FolderCache::FolderCache()
+    {
+        m_maxCost = qint64(PortalSettings::instance().folderCacheSize()) * 1024 * 1024;
+        connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &FolderCache::directoryChanged);
+    }
+
+    void FolderCache::retain(const std::shared_ptr<Fm::Folder> &folder)
+    {
+        if (!folder || m_maxCost == 0) {
+            return;
+        }
+        const int index = indexOf(folder.get());
+        if (index >= 0) {
+            m_entries.move(index, 0);
+            return;
+        }
+
+        const auto localPath = folder->path().localPath();
+        if (!localPath) {
+            return;
+        }
+        const QString path = QString::fromUtf8(localPath.get());
+        if (!isCacheableFilesystem(path)) {
+            return;
+        }
+        // without a watch a change could go unnoticed (e.g. the inotify limit is reached)
+        if (!m_watcher.addPath(path)) {
+            return;
+        }
+
+        m_entries.prepend(Entry{folder, path, 0});
+        const Fm::Folder *key = folder.get();
+        connect(key, &Fm::Folder::finishLoading, this, [this, key] { updateCost(key); });
+        // deleted or unmounted folders must not be handed out again
+        const auto drop = [this, key] {
+            const int i = indexOf(key);
+            if (i >= 0) {
+                remove(i);
+            }
+        };
+        connect(key, &Fm::Folder::removed, this, drop);
+        connect(key, &Fm::Folder::unmount, this, drop);
+        updateCost(key);
+    }
+
+    int FolderCache::indexOf(const Fm::Folder *folder) const
+    {
+        for (int i = 0; i < m_entries.size(); ++i) {
+            if (m_entries.at(i).folder.get() == folder) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void FolderCache::updateCost(const Fm::Folder *folder)
+    {
+        const int index = indexOf(folder);
+        if (index < 0) {
+            return;
+        }
+        Entry &entry = m_entries[index];
+        // files() copies the list, so this only runs when a folder is added or finishes loading
+        const qint64 cost = qint64(folder->files().size()) * CostPerFile;
+        m_cost += cost - entry.cost;
+        entry.cost = cost;
+        trim();
+    }
+
+    void FolderCache::directoryChanged(const QString &path)
+    {
+        for (int i = 0; i < m_entries.size(); ++i) {
+            // a folder a dialog is showing stays, its monitor updates the listing in place
+            if (m_entries.at(i).path == path && m_entries.at(i).folder.use_count() == 1) {
+                qCDebug(XdgDesktopPortalLxqtFolderCache) << "Dropping changed folder" << path;
+                remove(i);
+                return;
+            }
+        }
+    }
+
+    void FolderCache::remove(int index)
+    {
+        Entry entry = m_entries.takeAt(index);
+        m_cost -= entry.cost;
+        m_watcher.removePath(entry.path);
+        entry.folder->disconnect(this);
+    }
+
+    void FolderCache::trim()
+    {
+        // least recently used first; a single folder above the budget is not kept either
+        while (!m_entries.isEmpty() && (m_cost > m_maxCost || m_entries.size() > MaxEntries)) {
+            const int last = m_entries.size() - 1;
+            qCDebug(XdgDesktopPortalLxqtFolderCache) << "Evicting" << m_entries.at(last).path;
+            remove(last);
+        }
+    }
+}
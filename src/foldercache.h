@@ -0,0 +1,85 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QList>
+#include <QObject>
+
+#include <memory>
+
+namespace Fm
+{
+    class Folder;
+}
+
+namespace LXQt
+{
+    // Keeps the listings of recently shown folders alive across requests. libfm-qt only
+    // caches Fm::Folder instances while something references them, so without this every
+    // dialog enumerates, stats and MIME-sniffs its folder from scratch. Held folders are
+    // returned already loaded by Fm::Folder::fromPath().
+    // Keeping them current is left to the file monitor every Fm::Folder runs for as long as
+    // it exists, which also applies changes to the files' contents (new size and mtime).
+    // On top of that, a folder whose entries are created, deleted, renamed or change their
+    // attributes while no dialog shows it is dropped, so a new dialog lists it afresh. That
+    // watch is a QFileSystemWatcher, whose inotify mask for directories has no IN_MODIFY,
+    // so writes to a file inside do not drop the folder.
+    // Folders on network and FUSE filesystems are not cached.
+    class FolderCache : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static FolderCache &instance();
+
+        // marks folder as most recently used, adding it if it is cacheable
+        void retain(const std::shared_ptr<Fm::Folder> &folder);
+
+    private:
+        FolderCache();
+
+        struct Entry
+        {
+            std::shared_ptr<Fm::Folder> folder;
+            QString path;
+            qint64 cost;
+        };
+
+        int indexOf(const Fm::Folder *folder) const;
+        void updateCost(const Fm::Folder *folder);
+        void directoryChanged(const QString &path);
+        void remove(int index);
+        void trim();
+
+    private:
+        // most recently used first
+        QList<Entry> m_entries;
+        qint64 m_cost = 0;
+        qint64 m_maxCost;
+        QFileSystemWatcher m_watcher;
+    };
+}
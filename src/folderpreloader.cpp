@@ -0,0 +1,91 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "folderpreloader.h"
+#include "filedialoghelper.h"
+#include "foldercache.h"
+
+#include <QDir>
+#include <QLoggingCategory>
+
+#include <libfm-qt6/core/filepath.h>
+#include <libfm-qt6/core/folder.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtPreload, "xdp-lxqt-preload")
+
+    void FolderPreloader::start(const QUrl &url)
+    {
+        m_home = QUrl::fromLocalFile(QDir::homePath());
+        m_requested = url.isValid() ? url : m_home;
+        m_probe = DirectoryProbe::start(m_requested);
+        // a hung NFS home freezes the dialog just as well
+        m_homeProbe = m_requested == m_home ? m_probe : DirectoryProbe::start(m_home);
+    }
+
+    void FolderPreloader::poll()
+    {
+        if (m_folder || !m_probe.isFinished()) {
+            return;
+        }
+        if (m_probe.wait() != DirectoryProbe::TimedOut) {
+            preload(m_requested);
+        } else if (m_homeProbe.isFinished() && m_homeProbe.wait() != DirectoryProbe::TimedOut) {
+            preload(m_home);
+        }
+    }
+
+    QUrl FolderPreloader::folder()
+    {
+        QUrl url = m_requested;
+        if (m_probe.wait() == DirectoryProbe::TimedOut) {
+            m_unreachableFolder = m_requested.toLocalFile();
+            // the root filesystem is local
+            url = m_homeProbe.wait() != DirectoryProbe::TimedOut ? m_home : QUrl::fromLocalFile(QStringLiteral("/"));
+        }
+        preload(url);
+        return url;
+    }
+
+    void FolderPreloader::preload(const QUrl &url)
+    {
+        if (!url.isValid() || url == m_url) {
+            return;
+        }
+
+        FileDialogHelper::initLibFmQt();
+        const auto path = Fm::FilePath::fromUri(url.toEncoded().constData());
+        if (!path.isValid()) {
+            return;
+        }
+        // Folder::fromPath() returns the cached instance or creates one and starts its
+        // directory listing job right away
+        m_folder = Fm::Folder::fromPath(path);
+        FolderCache::instance().retain(m_folder);
+        m_url = url;
+        qCDebug(XdgDesktopPortalLxqtPreload) << "Preloading" << url << (m_folder->isLoaded() ? "(already loaded)" : "");
+    }
+}
@@ -0,0 +1,80 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include "directoryprobe.h"
+
+#include <QUrl>
+
+#include <memory>
+
+namespace Fm
+{
+    class Folder;
+}
+
+namespace LXQt
+{
+    // Picks the folder a dialog opens in and starts listing it early. The requested folder
+    // and the home folder, its fallback, are probed on threads as soon as a request's options
+    // are parsed. Listing starts once a probe is seen to have succeeded, so enumeration and
+    // file info queries run in libfm-qt's worker job while the dialog is being built.
+    // Fm::Folder instances are shared through libfm-qt's folder cache, so when the dialog
+    // calls setDirectory() its folder model adopts the (loading or loaded) prefetched folder.
+    // Nothing here runs an event loop, other portal calls don't come in mid-request.
+    class FolderPreloader
+    {
+    public:
+        FolderPreloader() = default;
+        FolderPreloader(const FolderPreloader &) = delete;
+        FolderPreloader &operator=(const FolderPreloader &) = delete;
+
+        // starts probing url (the home folder if it is invalid) and the home folder
+        void start(const QUrl &url);
+        // starts listing if a probe has succeeded by now, never waits
+        void poll();
+        // Waits for the probes, no longer than DirectoryProbe::DefaultTimeout from start(),
+        // and returns the folder to open: the requested one unless it timed out, else the
+        // home folder unless that did too, else the root folder.
+        QUrl folder();
+        // the requested folder if it timed out
+        QString unreachableFolder() const { return m_unreachableFolder; }
+
+    private:
+        void preload(const QUrl &url);
+
+    private:
+        QUrl m_requested;
+        DirectoryProbe::Pending m_probe;
+        QUrl m_home;
+        DirectoryProbe::Pending m_homeProbe;
+        QString m_unreachableFolder;
+
+        QUrl m_url;
+        // keeps the folder alive (and in libfm-qt's cache) until the dialog uses it
+        std::shared_ptr<Fm::Folder> m_folder;
+    };
+}
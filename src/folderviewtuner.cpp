@@ -0,0 +1,101 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "folderviewtuner.h"
+#include "foldercache.h"
+
+#include <QEvent>
+#include <QListView>
+#include <QTimer>
+#include <QTreeView>
+
+#include <libfm-qt6/core/folder.h>
+#include <libfm-qt6/filedialog.h>
+#include <libfm-qt6/foldermodel.h>
+#include <libfm-qt6/folderview.h>
+#include <libfm-qt6/proxyfoldermodel.h>
+
+namespace LXQt
+{
+    /*static*/ void FolderViewTuner::attach(Fm::FileDialog &dialog)
+    {
+        auto folderView = dialog.findChild<Fm::FolderView *>();
+        if (folderView == nullptr) {
+            return;
+        }
+        new FolderViewTuner{dialog, folderView};
+    }
+
+    FolderViewTuner::FolderViewTuner(Fm::FileDialog &dialog, Fm::FolderView *folderView)
+        : QObject{&dialog}
+        , m_folderView{folderView}
+    {
+        // FolderView recreates its child view when the view mode changes
+        folderView->installEventFilter(this);
+        connect(&dialog, &Fm::FileDialog::directoryEntered, this, &FolderViewTuner::trackFolder);
+        tuneChildView();
+        trackFolder();
+    }
+
+    bool FolderViewTuner::eventFilter(QObject *watched, QEvent *event)
+    {
+        if (watched == m_folderView && event->type() == QEvent::ChildAdded) {
+            QTimer::singleShot(0, this, &FolderViewTuner::tuneChildView);
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+    void FolderViewTuner::tuneChildView()
+    {
+        if (!m_folderView || m_folderView->childView() == m_childView) {
+            return;
+        }
+        m_childView = m_folderView->childView();
+        if (auto listView = qobject_cast<QListView *>(m_childView)) {
+            // icon, thumbnail and compact modes: lay out in chunks, measure one item
+            listView->setLayoutMode(QListView::Batched);
+            listView->setBatchSize(LayoutBatchSize);
+            listView->setUniformItemSizes(true);
+        } else if (auto treeView = qobject_cast<QTreeView *>(m_childView)) {
+            // detailed list mode
+            treeView->setUniformRowHeights(true);
+        }
+    }
+
+    void FolderViewTuner::trackFolder()
+    {
+        if (!m_folderView || m_folderView->model() == nullptr) {
+            return;
+        }
+        auto folderModel = qobject_cast<Fm::FolderModel *>(m_folderView->model()->sourceModel());
+        if (folderModel == nullptr || folderModel->folder() == m_folder) {
+            return;
+        }
+
+        m_folder = folderModel->folder();
+        // folders browsed to inside the dialog are worth keeping for the next request too
+        FolderCache::instance().retain(m_folder);
+    }
+}
@@ -0,0 +1,71 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+
+#include <memory>
+
+class QAbstractItemView;
+
+namespace Fm
+{
+    class FileDialog;
+    class Folder;
+    class FolderView;
+}
+
+namespace LXQt
+{
+    // Keeps the file dialog responsive while very large folders load. The views lay out
+    // items in batches per event loop iteration with uniform item sizes, so the first rows
+    // show up right away and scrolling or typing is not blocked by layouting 200k items.
+    class FolderViewTuner : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // items laid out per event loop iteration
+        static constexpr int LayoutBatchSize = 256;
+
+        // the tuner is owned by the dialog; does nothing if the dialog has no folder view
+        static void attach(Fm::FileDialog &dialog);
+
+    private:
+        FolderViewTuner(Fm::FileDialog &dialog, Fm::FolderView *folderView);
+
+        bool eventFilter(QObject *watched, QEvent *event) override;
+
+        void tuneChildView();
+        void trackFolder();
+
+    private:
+        QPointer<Fm::FolderView> m_folderView;
+        QPointer<QAbstractItemView> m_childView;
+        std::shared_ptr<Fm::Folder> m_folder;
+    };
+}
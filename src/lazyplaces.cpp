@@ -0,0 +1,228 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "lazyplaces.h"
+#include "directoryprobe.h"
+#include "mounttable.h"
+#include "portalsettings.h"
+
+#include <QDir>
+#include <QFile>
+#include <QLabel>
+#include <QLayout>
+#include <QLoggingCategory>
+#include <QSet>
+#include <QSplitter>
+#include <QStandardPaths>
+#include <QTreeWidget>
+
+#include <libfm-qt6/filedialog.h>
+#include <libfm-qt6/placesview.h>
+
+#include <pwd.h>
+#include <unistd.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtPlaces, "xdp-lxqt-places")
+
+    // the user asked for this place, give an automount or a waking server some time
+    static constexpr int OpenTimeout = 5000;
+
+    // pseudo and boot filesystems, systemd automounts some of them (binfmt_misc, /boot, /efi)
+    static bool isSystemMount(const QString &mountPoint)
+    {
+        static const QStringList systemPrefixes = {QStringLiteral("/proc"), QStringLiteral("/sys"), QStringLiteral("/dev"),
+                                                   QStringLiteral("/run"), QStringLiteral("/boot"), QStringLiteral("/efi")};
+        if (mountPoint.startsWith(QLatin1String("/run/media/"))) {
+            return false;
+        }
+        for (const QString &prefix : systemPrefixes) {
+            if (mountPoint == prefix || mountPoint.startsWith(prefix + QLatin1Char('/'))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Whether an automount leads to a network filesystem. Once mounted, the filesystem on top
+    // tells; before that, systemd automounts have their real type in fstab. Maps of the
+    // automounter daemon (source "auto.net", "/etc/auto.home" and the like) aren't in fstab
+    // and serve network shares in practice.
+    static bool isRemoteAutomount(const MountEntry &mount, const MountEntry &top, const QList<MountEntry> &configured)
+    {
+        if (!top.isAutomount()) {
+            return top.isRemote();
+        }
+        for (const MountEntry &entry : configured) {
+            if (entry.mountPoint == mount.mountPoint) {
+                return entry.isRemote();
+            }
+        }
+        return mount.source != QLatin1String("systemd-1");
+    }
+
+    static QString userName()
+    {
+        if (const struct passwd *pw = ::getpwuid(::getuid())) {
+            return QString::fromLocal8Bit(pw->pw_name);
+        }
+        return qEnvironmentVariable("USER");
+    }
+
+    /*static*/ void LazyPlaces::attach(Fm::FileDialog &dialog)
+    {
+        if (!PortalSettings::instance().lazyPlaces() || dialog.layout() == nullptr) {
+            return;
+        }
+        // libfm-qt's sidebar lists GIO's volume monitor; it is replaced, not filtered
+        auto placesView = dialog.findChild<Fm::PlacesView *>();
+        if (placesView == nullptr || placesView->parentWidget() == nullptr) {
+            return;
+        }
+        new LazyPlaces{dialog, placesView, collect()};
+    }
+
+    /*static*/ QList<LazyPlaces::Place> LazyPlaces::collect()
+    {
+        QList<Place> places;
+        const QList<MountEntry> mounts = MountTable::read();
+        const QList<MountEntry> configured = MountTable::readConfigured();
+
+        const QString home = QDir::homePath();
+        places << Place{Places, tr("Home"), QUrl::fromLocalFile(home), QStringLiteral("user-home"), home};
+        const QString desktop = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+        if (!desktop.isEmpty() && desktop != home) {
+            places << Place{Places, tr("Desktop"), QUrl::fromLocalFile(desktop), QStringLiteral("user-desktop"), desktop};
+        }
+        places << Place{Places, tr("Trash"), QUrl{QStringLiteral("trash:///")}, QStringLiteral("user-trash"), QString{}};
+        places << Place{Places, tr("File System"), QUrl::fromLocalFile(QStringLiteral("/")), QStringLiteral("drive-harddisk"), QString{}};
+
+        QSet<QString> lazyMountPoints;
+        QList<Place> network;
+        // where GIO shows user mountable filesystems
+        const QString userMedia = QStringLiteral("/run/media/%1/").arg(userName());
+        QSet<QString> seen;
+        for (const MountEntry &mount : mounts) {
+            if (seen.contains(mount.mountPoint)) {
+                continue;
+            }
+            seen << mount.mountPoint;
+            if (isSystemMount(mount.mountPoint)) {
+                continue;
+            }
+            const MountEntry *top = MountTable::topmost(mount.mountPoint, mounts);
+            const QString label = QDir{mount.mountPoint}.dirName();
+            if (mount.isRemote() || (mount.isAutomount() && isRemoteAutomount(mount, *top, configured))) {
+                lazyMountPoints << mount.mountPoint;
+                network << Place{Network, label.isEmpty() ? mount.mountPoint : label,
+                    QUrl::fromLocalFile(mount.mountPoint), QStringLiteral("folder-remote"),
+                    top->isAutomount() ? tr("%1 (not mounted)").arg(mount.mountPoint) : QStringLiteral("%1 (%2)").arg(top->source, top->fsType)};
+            } else if (mount.mountPoint.startsWith(QLatin1String("/media/")) || mount.mountPoint.startsWith(userMedia)) {
+                places << Place{Devices, label, QUrl::fromLocalFile(mount.mountPoint), QStringLiteral("drive-removable-media"),
+                    QStringLiteral("%1 (%2)").arg(top->source, top->fsType)};
+            }
+        }
+
+        // same file libfm-qt reads its bookmarks from
+        QFile bookmarks{QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + QStringLiteral("/gtk-3.0/bookmarks")};
+        if (bookmarks.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            while (!bookmarks.atEnd()) {
+                const QString line = QString::fromUtf8(bookmarks.readLine()).trimmed();
+                const int space = line.indexOf(QLatin1Char(' '));
+                const QUrl url{space < 0 ? line : line.left(space)};
+                if (!url.isValid() || url.isEmpty()) {
+                    continue;
+                }
+                const QString label = space < 0 ? url.fileName() : line.mid(space + 1);
+                const bool lazy = !url.isLocalFile() || lazyMountPoints.contains(MountTable::mountPointOf(url.toLocalFile(), mounts));
+                Place place{lazy ? Network : Bookmarks, label.isEmpty() ? url.toDisplayString() : label, url,
+                    lazy && !url.isLocalFile() ? QStringLiteral("network-server") : QStringLiteral("folder"), url.toDisplayString()};
+                (lazy ? network : places) << place;
+            }
+        }
+        return places + network;
+    }
+
+    LazyPlaces::LazyPlaces(Fm::FileDialog &dialog, QAbstractItemView *placesView, const QList<Place> &places)
+        : QObject{&dialog}
+        , m_dialog{dialog}
+        , m_places{places}
+    {
+        m_sidebar = new QTreeWidget;
+        m_sidebar->setHeaderHidden(true);
+        m_sidebar->setRootIsDecorated(false);
+        m_sidebar->setItemsExpandable(false);
+        m_sidebar->setIconSize(placesView->iconSize());
+        const QStringList sectionTitles = {tr("Places"), tr("Devices"), tr("Bookmarks"), tr("Network")};
+        QTreeWidgetItem *section = nullptr;
+        for (int i = 0; i < m_places.size(); ++i) {
+            const Place &place = m_places.at(i);
+            if (section == nullptr || section->data(0, Qt::UserRole).toInt() != place.section) {
+                section = new QTreeWidgetItem{m_sidebar, {sectionTitles.at(place.section)}};
+                section->setData(0, Qt::UserRole, place.section);
+                section->setFlags(Qt::ItemIsEnabled);
+            }
+            auto item = new QTreeWidgetItem{section, {place.label}};
+            item->setIcon(0, QIcon::fromTheme(place.icon));
+            item->setToolTip(0, place.detail);
+            item->setData(0, Qt::UserRole, i);
+        }
+        m_sidebar->expandAll();
+        connect(m_sidebar, &QTreeWidget::itemClicked, this, &LazyPlaces::open);
+
+        // take the place of libfm-qt's sidebar, which stays hidden
+        if (auto splitter = qobject_cast<QSplitter *>(placesView->parentWidget())) {
+            splitter->insertWidget(splitter->indexOf(placesView), m_sidebar);
+        } else if (auto layout = placesView->parentWidget()->layout()) {
+            layout->replaceWidget(placesView, m_sidebar);
+        }
+        placesView->hide();
+
+        m_notice = new QLabel;
+        m_notice->setWordWrap(true);
+        m_notice->hide();
+        dialog.layout()->addWidget(m_notice);
+    }
+
+    void LazyPlaces::open(QTreeWidgetItem *item)
+    {
+        // section headers have no parent
+        if (item == nullptr || item->parent() == nullptr) {
+            return;
+        }
+        const Place &place = m_places.at(item->data(0, Qt::UserRole).toInt());
+        qCDebug(XdgDesktopPortalLxqtPlaces) << "Opening" << place.url;
+        m_notice->hide();
+        // remote URIs go to GIO, which doesn't block the GUI thread
+        if (place.section == Network && place.url.isLocalFile()
+                && DirectoryProbe::probe(place.url, OpenTimeout) != DirectoryProbe::Reachable) {
+            m_notice->setText(tr("\"%1\" is not reachable right now.").arg(place.label));
+            m_notice->show();
+            return;
+        }
+        m_dialog.setDirectory(place.url);
+    }
+}
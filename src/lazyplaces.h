@@ -0,0 +1,91 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+class QAbstractItemView;
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+namespace Fm
+{
+    class FileDialog;
+}
+
+namespace LXQt
+{
+    // Lazy places mode (PortalSettings::lazyPlaces()): the dialog's sidebar is replaced by
+    // one built only from /proc/self/mountinfo, /etc/fstab, the XDG user dirs and the GTK
+    // bookmarks file, with network mounts and automounts of network shares in a "Network"
+    // section; system mounts (/proc, /sys, /boot and the like) are left out. The sidebar doesn't
+    // ask GIO about any mount, and nothing touches those mount points until the user picks
+    // one; the folder is then probed off the GUI thread before the dialog goes there, so an
+    // unreachable server cannot freeze it.
+    class LazyPlaces : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum Section {
+            Places,
+            Devices,
+            Bookmarks,
+            Network
+        };
+
+        struct Place
+        {
+            Section section;
+            QString label;
+            QUrl url;
+            QString icon;
+            // source and filesystem type, shown as tooltip
+            QString detail;
+        };
+
+        // does nothing unless lazy places are enabled
+        static void attach(Fm::FileDialog &dialog);
+
+        // the sidebar's entries in section order; Network holds the automount/network
+        // mounts and the bookmarks pointing into them or to remote URIs
+        static QList<Place> collect();
+
+    private:
+        LazyPlaces(Fm::FileDialog &dialog, QAbstractItemView *placesView, const QList<Place> &places);
+
+        void open(QTreeWidgetItem *item);
+
+    private:
+        Fm::FileDialog &m_dialog;
+        QList<Place> m_places;
+        QTreeWidget *m_sidebar;
+        QLabel *m_notice;
+    };
+}
@@ -29,25 +29,34 @@
 
 #include <QApplication>
 #include <QDBusConnection>
+#include <QElapsedTimer>
 #include <QLoggingCategory>
 
 #include "desktopportal.h"
+#include "dialogworker.h"
 
 Q_LOGGING_CATEGORY(XdgDesktopPortalLxqt, "xdp-lxqt")
 
 int main(int argc, char *argv[])
 {
+    QElapsedTimer startup;
+    startup.start();
+
     QCoreApplication::setAttribute(Qt::AA_DisableSessionManager);
     QApplication a{argc, argv};
     a.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt"));
     a.setQuitOnLastWindowClosed(false);
 
+    if (a.arguments().contains(QStringLiteral("--dialog-worker"))) {
+        return LXQt::DialogWorkerPool::exec();
+    }
+
     QDBusConnection sessionBus = QDBusConnection::sessionBus();
 
     if (sessionBus.registerService(QStringLiteral("org.freedesktop.impl.portal.desktop.lxqt"))) {
         const auto desktopPortal = new LXQt::DesktopPortal{&a};
         if (sessionBus.registerObject(QStringLiteral("/org/freedesktop/portal/desktop"), desktopPortal, QDBusConnection::ExportAdaptors)) {
-            qCDebug(XdgDesktopPortalLxqt) << "Desktop portal registered successfully";
+            qCDebug(XdgDesktopPortalLxqt) << "Desktop portal registered successfully in" << startup.elapsed() << "ms";
         } else {
             qCDebug(XdgDesktopPortalLxqt) << "Failed to register desktop portal";
         }
@@ -0,0 +1,142 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "mounttable.h"
+
+#include <QFile>
+#include <QStringList>
+
+namespace LXQt
+{
+    namespace
+    {
+        // decodes the octal escapes (\040 etc.) used in /proc/self/mountinfo
+        QByteArray unescapeMountField(const QByteArray &field)
+        {
+            QByteArray result;
+            result.reserve(field.size());
+            for (int i = 0; i < field.size(); ++i) {
+                if (field.at(i) == '\\' && i + 3 < field.size()) {
+                    bool ok = false;
+                    const int c = field.mid(i + 1, 3).toInt(&ok, 8);
+                    if (ok) {
+                        result += static_cast<char>(c);
+                        i += 3;
+                        continue;
+                    }
+                }
+                result += field.at(i);
+            }
+            return result;
+        }
+    }
+
+    bool MountEntry::isRemote() const
+    {
+        static const QStringList remoteTypes = {
+            QStringLiteral("nfs"), QStringLiteral("nfs4"), QStringLiteral("cifs"), QStringLiteral("smb3"),
+            QStringLiteral("smbfs"), QStringLiteral("ncpfs"), QStringLiteral("9p"), QStringLiteral("afs"),
+            QStringLiteral("ceph"), QStringLiteral("glusterfs"), QStringLiteral("lustre"), QStringLiteral("gpfs"),
+            QStringLiteral("davfs"), QStringLiteral("fuse.sshfs"), QStringLiteral("fuse.rclone"),
+            QStringLiteral("fuse.davfs2"), QStringLiteral("fuse.s3fs"), QStringLiteral("fuse.gvfsd-fuse")
+        };
+        return remoteTypes.contains(fsType);
+    }
+
+    /*static*/ QList<MountEntry> MountTable::read()
+    {
+        QList<MountEntry> mounts;
+        QFile mountInfo{QStringLiteral("/proc/self/mountinfo")};
+        if (!mountInfo.open(QIODevice::ReadOnly)) {
+            return mounts;
+        }
+        // /proc files report a size of 0, so read line by line
+        while (!mountInfo.atEnd()) {
+            // id parent major:minor root mount-point options [optional...] - type source super-options
+            const QList<QByteArray> fields = mountInfo.readLine().trimmed().split(' ');
+            const int separator = fields.indexOf("-");
+            if (fields.size() < 5 || separator < 0 || separator + 2 >= fields.size()) {
+                continue;
+            }
+            mounts << MountEntry{
+                QFile::decodeName(unescapeMountField(fields.at(4))),
+                QString::fromLatin1(fields.at(separator + 1)),
+                QFile::decodeName(unescapeMountField(fields.at(separator + 2)))
+            };
+        }
+        return mounts;
+    }
+
+    /*static*/ QList<MountEntry> MountTable::readConfigured()
+    {
+        QList<MountEntry> mounts;
+        QFile fstab{QStringLiteral("/etc/fstab")};
+        if (!fstab.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return mounts;
+        }
+        while (!fstab.atEnd()) {
+            // source mount-point type options [dump [pass]]
+            const QByteArray line = fstab.readLine().simplified();
+            if (line.isEmpty() || line.startsWith('#')) {
+                continue;
+            }
+            const QList<QByteArray> fields = line.split(' ');
+            if (fields.size() < 3) {
+                continue;
+            }
+            mounts << MountEntry{
+                QFile::decodeName(unescapeMountField(fields.at(1))),
+                QString::fromLatin1(fields.at(2)),
+                QFile::decodeName(unescapeMountField(fields.at(0)))
+            };
+        }
+        return mounts;
+    }
+
+    /*static*/ QString MountTable::mountPointOf(const QString &path, const QList<MountEntry> &mounts)
+    {
+        QString best;
+        for (const MountEntry &mount : mounts) {
+            const QString &mountPoint = mount.mountPoint;
+            const bool contains = path == mountPoint
+                || (path.startsWith(mountPoint) && (mountPoint.endsWith(QLatin1Char('/')) || path.at(mountPoint.size()) == QLatin1Char('/')));
+            if (contains && mountPoint.size() > best.size()) {
+                best = mountPoint;
+            }
+        }
+        return best.isEmpty() ? path : best;
+    }
+
+    /*static*/ const MountEntry *MountTable::topmost(const QString &mountPoint, const QList<MountEntry> &mounts)
+    {
+        // mountinfo lists mounts in mount order
+        for (int i = mounts.size() - 1; i >= 0; --i) {
+            if (mounts.at(i).mountPoint == mountPoint) {
+                return &mounts.at(i);
+            }
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,61 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+
+namespace LXQt
+{
+    struct MountEntry
+    {
+        QString mountPoint;
+        QString fsType;
+        QString source;
+
+        // automount trigger points, the real filesystem is mounted on first access
+        bool isAutomount() const { return fsType == QLatin1String("autofs"); }
+        // network filesystems, whose access can block on the server
+        bool isRemote() const;
+    };
+
+    // The current mounts as listed in /proc/self/mountinfo. Reading the table doesn't touch
+    // any mount point, so it neither triggers automounts nor blocks on a dead server.
+    class MountTable
+    {
+    public:
+        static QList<MountEntry> read();
+        // the filesystems configured in /etc/fstab, mounted or not; an automount's real type
+        static QList<MountEntry> readConfigured();
+
+        // longest mount point containing path, or path if there is none
+        static QString mountPointOf(const QString &path, const QList<MountEntry> &mounts);
+        static QString mountPointOf(const QString &path) { return mountPointOf(path, read()); }
+
+        // the entry mounted last on mountPoint (the real filesystem on top of an autofs one)
+        static const MountEntry *topmost(const QString &mountPoint, const QList<MountEntry> &mounts);
+    };
+}
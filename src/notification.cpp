@@ -0,0 +1,72 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "notification.h"
+#include "notificationforwarder.h"
+
+#include <QDBusConnection>
+#include <QLoggingCategory>
+
+namespace LXQt
+{
+    Q_DECLARE_LOGGING_CATEGORY(XdgDesktopPortalLxqtNotification)
+
+    NotificationPortal::NotificationPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    NotificationForwarder *NotificationPortal::forwarder()
+    {
+        // subscribing to the notification server's signals costs bus round trips, so it
+        // waits for the first notification
+        if (m_forwarder == nullptr) {
+            m_forwarder = new NotificationForwarder{QDBusConnection::sessionBus(), this};
+            connect(m_forwarder, &NotificationForwarder::actionInvoked, this, &NotificationPortal::ActionInvoked);
+        }
+        return m_forwarder;
+    }
+
+    void NotificationPortal::AddNotification(const QString &app_id, const QString &id, const QVariantMap &notification)
+    {
+        qCDebug(XdgDesktopPortalLxqtNotification) << "AddNotification called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtNotification) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtNotification) << "    id: " << id;
+        qCDebug(XdgDesktopPortalLxqtNotification) << "    notification: " << notification;
+
+        forwarder()->add(app_id, id, notification);
+    }
+
+    void NotificationPortal::RemoveNotification(const QString &app_id, const QString &id)
+    {
+        qCDebug(XdgDesktopPortalLxqtNotification) << "RemoveNotification called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtNotification) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtNotification) << "    id: " << id;
+
+        if (m_forwarder) {
+            m_forwarder->remove(app_id, id);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+#include <QVariantMap>
+
+namespace LXQt
+{
+    class NotificationForwarder;
+
+    class NotificationPortal : public QDBusAbstractAdaptor
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.impl.portal.Notification")
+        Q_PROPERTY(QVariantMap SupportedOptions READ supportedOptions CONSTANT)
+        Q_PROPERTY(uint version READ version CONSTANT)
+    public:
+        explicit NotificationPortal(QObject *parent);
+
+        QVariantMap supportedOptions() const { return {}; }
+        uint version() const { return 2; }
+
+    public Q_SLOTS:
+        void AddNotification(const QString &app_id, const QString &id, const QVariantMap &notification);
+        void RemoveNotification(const QString &app_id, const QString &id);
+
+    Q_SIGNALS:
+        void ActionInvoked(const QString &app_id, const QString &id, const QString &action, const QVariantList &parameter);
+
+    private:
+        NotificationForwarder *forwarder();
+
+    private:
+        NotificationForwarder *m_forwarder = nullptr;
+    };
+}
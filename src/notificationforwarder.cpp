@@ -0,0 +1,384 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "notificationforwarder.h"
+#include "desktopappindex.h"
+#include "portalsettings.h"
+
+#include <QDBusArgument>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusUnixFileDescriptor>
+#include <QDBusVariant>
+#include <QFile>
+#include <QImage>
+#include <QLoggingCategory>
+#include <QThread>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtNotification, "xdp-lxqt-notification")
+
+    static const QString NotificationsService = QStringLiteral("org.freedesktop.Notifications");
+    static const QString NotificationsPath = QStringLiteral("/org/freedesktop/Notifications");
+    static const QString NotificationsInterface = QStringLiteral("org.freedesktop.Notifications");
+
+    // the largest icon side sent to the server, larger images are scaled down
+    static constexpr int MaxIconSize = 128;
+    // refuse to decode icon files larger than this
+    static constexpr qint64 MaxIconFileSize = 4 * 1024 * 1024;
+    // the application index is built once notifications have been quiet this long
+    static constexpr int IndexIdleDelay = 2000;
+
+    NotificationForwarder::NotificationForwarder(const QDBusConnection &connection, QObject *parent)
+        : QObject(parent)
+        , m_connection{connection}
+    {
+        qDBusRegisterMetaType<QList<QVariantMap>>();
+
+        m_batchTimer.setSingleShot(true);
+        m_batchTimer.setInterval(PortalSettings::instance().notificationBatchWindow());
+        connect(&m_batchTimer, &QTimer::timeout, this, &NotificationForwarder::flush);
+
+        // scanning every .desktop file takes a while, so it is not done for the first
+        // notification of a burst; until then the app id stands in for name and icon
+        m_indexTimer.setSingleShot(true);
+        m_indexTimer.setInterval(IndexIdleDelay);
+        connect(&m_indexTimer, &QTimer::timeout, this, [] {
+            DesktopAppIndex::instance();
+        });
+
+        m_decoders.setMaxThreadCount(1);
+        m_decoders.setThreadPriority(QThread::LowPriority);
+
+        m_connection.connect(NotificationsService, NotificationsPath, NotificationsInterface, QStringLiteral("ActionInvoked"),
+                this, SLOT(onActionInvoked(uint, QString)));
+        m_connection.connect(NotificationsService, NotificationsPath, NotificationsInterface, QStringLiteral("NotificationClosed"),
+                this, SLOT(onNotificationClosed(uint, uint)));
+    }
+
+    NotificationForwarder::~NotificationForwarder()
+    {
+        // pending decodes post back to this object
+        m_decoders.clear();
+        m_decoders.waitForDone();
+    }
+
+    NotificationForwarder::Request NotificationForwarder::translate(const QString &appId, const QVariantMap &notification, QVariant &icon) const
+    {
+        Request request;
+        const DesktopAppIndex::Application *application = appId.isEmpty() || !DesktopAppIndex::isBuilt() ? nullptr : DesktopAppIndex::instance().application(appId);
+        request.appName = application ? application->name : appId;
+        if (!appId.isEmpty()) {
+            request.hints.insert(QStringLiteral("desktop-entry"), appId);
+        }
+
+        request.summary = notification.value(QStringLiteral("title")).toString();
+        if (notification.contains(QStringLiteral("markup-body"))) {
+            request.body = notification.value(QStringLiteral("markup-body")).toString();
+        } else {
+            request.body = notification.value(QStringLiteral("body")).toString().toHtmlEscaped();
+        }
+
+        if (notification.contains(QStringLiteral("icon"))) {
+            const QDBusArgument argument = notification.value(QStringLiteral("icon")).value<QDBusArgument>();
+            QString type;
+            QDBusVariant value;
+            argument.beginStructure();
+            argument >> type >> value;
+            argument.endStructure();
+            if (type == QLatin1String("themed")) {
+                request.appIcon = value.variant().toStringList().value(0);
+            } else if (type == QLatin1String("bytes") || type == QLatin1String("file-descriptor")) {
+                icon = value.variant();
+            }
+        } else if (application) {
+            request.appIcon = application->icon;
+        }
+
+        const QString priority = notification.value(QStringLiteral("priority")).toString();
+        uchar urgency = 1;
+        if (priority == QLatin1String("low")) {
+            urgency = 0;
+        } else if (priority == QLatin1String("high") || priority == QLatin1String("urgent")) {
+            urgency = 2;
+        }
+        request.hints.insert(QStringLiteral("urgency"), QVariant::fromValue(urgency));
+
+        if (notification.contains(QStringLiteral("category"))) {
+            request.hints.insert(QStringLiteral("category"), notification.value(QStringLiteral("category")).toString());
+        }
+        if (notification.value(QStringLiteral("sound")).toString() == QLatin1String("silent")) {
+            request.hints.insert(QStringLiteral("suppress-sound"), true);
+        }
+        const QStringList displayHints = notification.value(QStringLiteral("display-hint")).toStringList();
+        if (displayHints.contains(QStringLiteral("transient"))) {
+            request.hints.insert(QStringLiteral("transient"), true);
+        }
+        if (displayHints.contains(QStringLiteral("persistent"))) {
+            request.hints.insert(QStringLiteral("resident"), true);
+        }
+        request.showAsNew = displayHints.contains(QStringLiteral("show-as-new"));
+
+        if (notification.contains(QStringLiteral("default-action"))) {
+            const QString action = notification.value(QStringLiteral("default-action")).toString();
+            // the server reports the "default" key, ActionInvoked needs the app's action name
+            request.actions << QStringLiteral("default") << QString{};
+            request.targets.insert(QStringLiteral("default"), notification.value(QStringLiteral("default-action-target")));
+            request.defaultAction = action;
+        }
+        const QList<QVariantMap> buttons = qdbus_cast<QList<QVariantMap>>(notification.value(QStringLiteral("buttons")));
+        for (const QVariantMap &button : buttons) {
+            const QString action = button.value(QStringLiteral("action")).toString();
+            if (action.isEmpty()) {
+                continue;
+            }
+            request.actions << action << button.value(QStringLiteral("label")).toString();
+            request.targets.insert(action, button.value(QStringLiteral("target")));
+        }
+        return request;
+    }
+
+    void NotificationForwarder::add(const QString &appId, const QString &id, const QVariantMap &notification)
+    {
+        if (!appId.isEmpty() && !DesktopAppIndex::isBuilt()) {
+            m_indexTimer.start();
+        }
+
+        const Key key{appId, id};
+        Entry &entry = m_entries[key];
+        QVariant icon;
+        entry.pending = translate(appId, notification, icon);
+        entry.hasPending = true;
+        entry.closeRequested = false;
+        ++entry.generation;
+
+        entry.decoding = icon.isValid();
+        if (entry.decoding) {
+            decodeIcon(key, entry.generation, icon);
+        } else {
+            enqueue(key, entry);
+        }
+    }
+
+    void NotificationForwarder::decodeIcon(const Key &key, quint64 generation, const QVariant &icon)
+    {
+        QByteArray bytes;
+        QDBusUnixFileDescriptor fd;
+        if (icon.userType() == qMetaTypeId<QDBusUnixFileDescriptor>()) {
+            // the copy keeps the fd open until the worker is done with it
+            fd = icon.value<QDBusUnixFileDescriptor>();
+        } else {
+            bytes = icon.toByteArray();
+        }
+
+        m_decoders.start([this, key, generation, bytes, fd] {
+            QImage image;
+            if (fd.isValid()) {
+                QFile file;
+                if (file.open(fd.fileDescriptor(), QIODevice::ReadOnly) && file.size() <= MaxIconFileSize) {
+                    image.loadFromData(file.readAll());
+                }
+            } else {
+                image.loadFromData(bytes);
+            }
+            if (!image.isNull()) {
+                if (image.width() > MaxIconSize || image.height() > MaxIconSize) {
+                    image = image.scaled(MaxIconSize, MaxIconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                }
+                image = image.convertToFormat(QImage::Format_RGBA8888);
+            }
+
+            QMetaObject::invokeMethod(this, [this, key, generation, image] {
+                auto it = m_entries.find(key);
+                if (it == m_entries.end() || it->generation != generation) {
+                    // removed or replaced meanwhile
+                    return;
+                }
+                if (!image.isNull()) {
+                    it->pending.hints.insert(QStringLiteral("image-data"), imageData(image));
+                } else {
+                    qCDebug(XdgDesktopPortalLxqtNotification) << "Cannot decode the icon of" << key.first << key.second;
+                }
+                it->decoding = false;
+                enqueue(key, *it);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    /*static*/ QVariant NotificationForwarder::imageData(const QImage &image)
+    {
+        // (iiibiiay): width, height, rowstride, has alpha, bits per sample, channels, data
+        QDBusArgument argument;
+        argument.beginStructure();
+        argument << image.width() << image.height() << static_cast<int>(image.bytesPerLine()) << image.hasAlphaChannel() << 8 << 4
+                 << QByteArray{reinterpret_cast<const char *>(image.constBits()), static_cast<int>(image.sizeInBytes())};
+        argument.endStructure();
+        return QVariant::fromValue(argument);
+    }
+
+    void NotificationForwarder::enqueue(const Key &key, Entry &entry)
+    {
+        // an entry in flight is sent again from its reply
+        if (entry.queued || entry.inFlight) {
+            return;
+        }
+        entry.queued = true;
+        m_queue.append(key);
+        if (!m_batchTimer.isActive()) {
+            m_batchTimer.start();
+        }
+    }
+
+    void NotificationForwarder::flush()
+    {
+        const QList<Key> queue = m_queue;
+        m_queue.clear();
+        for (const Key &key : queue) {
+            auto it = m_entries.find(key);
+            if (it == m_entries.end()) {
+                continue;
+            }
+            it->queued = false;
+            if (it->hasPending && !it->decoding && !it->inFlight) {
+                send(key, *it);
+            }
+        }
+    }
+
+    void NotificationForwarder::send(const Key &key, Entry &entry)
+    {
+        Request &request = entry.pending;
+        QDBusMessage message = QDBusMessage::createMethodCall(NotificationsService, NotificationsPath, NotificationsInterface, QStringLiteral("Notify"));
+        message << request.appName << (request.showAsNew ? 0u : entry.serverId) << request.appIcon << request.summary << request.body
+                << request.actions << request.hints << -1;
+
+        entry.targets = request.targets;
+        entry.defaultAction = request.defaultAction;
+        entry.pending = Request{};
+        entry.hasPending = false;
+        entry.inFlight = true;
+
+        auto watcher = new QDBusPendingCallWatcher{m_connection.asyncCall(message), this};
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, key](QDBusPendingCallWatcher *w) {
+            onNotifyReplied(w, key);
+        });
+    }
+
+    void NotificationForwarder::onNotifyReplied(QDBusPendingCallWatcher *watcher, const Key &key)
+    {
+        const QDBusPendingReply<uint> reply = *watcher;
+        watcher->deleteLater();
+
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return;
+        }
+        it->inFlight = false;
+
+        if (reply.isError()) {
+            qCWarning(XdgDesktopPortalLxqtNotification) << "Notify failed:" << reply.error().message();
+        } else {
+            const uint serverId = reply.value();
+            if (it->serverId != serverId) {
+                if (it->serverId != 0) {
+                    m_keysByServerId.remove(it->serverId);
+                }
+                it->serverId = serverId;
+                m_keysByServerId.insert(serverId, key);
+            }
+        }
+
+        if (it->closeRequested) {
+            close(it->serverId);
+            m_entries.erase(it);
+        } else if (it->hasPending) {
+            enqueue(key, *it);
+        }
+    }
+
+    void NotificationForwarder::remove(const QString &appId, const QString &id)
+    {
+        auto it = m_entries.find(Key{appId, id});
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (it->inFlight) {
+            it->closeRequested = true;
+            it->hasPending = false;
+            return;
+        }
+        // never shown if it was still waiting for the batch window or its icon
+        close(it->serverId);
+        m_entries.erase(it);
+    }
+
+    void NotificationForwarder::close(uint serverId)
+    {
+        if (serverId == 0) {
+            return;
+        }
+        m_keysByServerId.remove(serverId);
+        m_connection.call(QDBusMessage::createMethodCall(NotificationsService, NotificationsPath, NotificationsInterface, QStringLiteral("CloseNotification")) << serverId,
+                QDBus::NoBlock);
+    }
+
+    void NotificationForwarder::onActionInvoked(uint serverId, const QString &actionKey)
+    {
+        const auto keyIt = m_keysByServerId.constFind(serverId);
+        if (keyIt == m_keysByServerId.cend()) {
+            return;
+        }
+        const Entry entry = m_entries.value(*keyIt);
+        QString action = actionKey;
+        if (actionKey == QLatin1String("default")) {
+            action = entry.defaultAction;
+        }
+        QVariantList parameter;
+        const QVariant target = entry.targets.value(actionKey);
+        if (target.isValid()) {
+            parameter << target;
+        }
+        Q_EMIT actionInvoked(keyIt->first, keyIt->second, action, parameter);
+    }
+
+    void NotificationForwarder::onNotificationClosed(uint serverId, uint reason)
+    {
+        Q_UNUSED(reason)
+        const Key key = m_keysByServerId.take(serverId);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end() || it->serverId != serverId) {
+            return;
+        }
+        if (it->hasPending || it->inFlight) {
+            // an update is on its way, it shows up as a new notification
+            it->serverId = 0;
+        } else {
+            m_entries.erase(it);
+        }
+    }
+}
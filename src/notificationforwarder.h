@@ -0,0 +1,117 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDBusConnection>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariantMap>
+
+class QDBusPendingCallWatcher;
+class QImage;
+
+namespace LXQt
+{
+    // Translates portal notifications into org.freedesktop.Notifications calls.
+    //
+    // Updates are not forwarded one by one: add() only records the latest content for a
+    // notification and a short batch window collects a burst, which is then sent back to
+    // back without waiting for replies. An update that arrives while an earlier one is
+    // still pending or in flight replaces it, so a notification that changes ten times
+    // within the window costs one Notify with replaces_id. Icons given as bytes or fd are
+    // decoded and scaled on a worker thread before the notification is released.
+    class NotificationForwarder : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit NotificationForwarder(const QDBusConnection &connection, QObject *parent = nullptr);
+        ~NotificationForwarder() override;
+
+        void add(const QString &appId, const QString &id, const QVariantMap &notification);
+        void remove(const QString &appId, const QString &id);
+
+    Q_SIGNALS:
+        void actionInvoked(const QString &appId, const QString &id, const QString &action, const QVariantList &parameter);
+
+    private Q_SLOTS:
+        void onActionInvoked(uint serverId, const QString &actionKey);
+        void onNotificationClosed(uint serverId, uint reason);
+
+    private:
+        using Key = QPair<QString, QString>;
+
+        // arguments of one Notify call
+        struct Request {
+            QString appName;
+            QString appIcon;
+            QString summary;
+            QString body;
+            QStringList actions;
+            QVariantMap hints;
+            bool showAsNew = false;
+            QString defaultAction;
+            QHash<QString, QVariant> targets;
+        };
+
+        struct Entry {
+            uint serverId = 0;
+            quint64 generation = 0;
+            bool hasPending = false;
+            bool decoding = false;
+            bool queued = false;
+            bool inFlight = false;
+            bool closeRequested = false;
+            Request pending;
+            // actions of the notification currently shown
+            QString defaultAction;
+            QHash<QString, QVariant> targets;
+        };
+
+        Request translate(const QString &appId, const QVariantMap &notification, QVariant &icon) const;
+        void decodeIcon(const Key &key, quint64 generation, const QVariant &icon);
+        void enqueue(const Key &key, Entry &entry);
+        void flush();
+        void send(const Key &key, Entry &entry);
+        void onNotifyReplied(QDBusPendingCallWatcher *watcher, const Key &key);
+        void close(uint serverId);
+
+        static QVariant imageData(const QImage &image);
+
+    private:
+        QDBusConnection m_connection;
+        QHash<Key, Entry> m_entries;
+        QHash<uint, Key> m_keysByServerId;
+        QList<Key> m_queue;
+        QTimer m_batchTimer;
+        QTimer m_indexTimer;
+        QThreadPool m_decoders;
+    };
+}
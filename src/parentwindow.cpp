@@ -0,0 +1,243 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "parentwindow.h"
+#include "utils.h"
+
+#include <KWindowSystem>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#ifdef HAVE_XCB
+#include <QAbstractNativeEventFilter>
+#include <xcb/xcb.h>
+#endif
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtParent, "xdp-lxqt-parent")
+
+    namespace
+    {
+        bool isX11Handle(const QString &parent_window)
+        {
+            return parent_window.startsWith(QLatin1String("x11:"));
+        }
+
+        WId x11Window(const QString &parent_window)
+        {
+            return parent_window.mid(4).toULongLong(nullptr, 16);
+        }
+
+#ifdef HAVE_XCB
+        xcb_connection_t *xcbConnection()
+        {
+            auto x11App = qGuiApp ? qGuiApp->nativeInterface<QNativeInterface::QX11Application>() : nullptr;
+            return x11App ? x11App->connection() : nullptr;
+        }
+
+        // all state lives in the GUI thread, like the D-Bus calls that use it
+        class X11Validator : public QAbstractNativeEventFilter
+        {
+        public:
+            static X11Validator &instance()
+            {
+                static X11Validator validator;
+                return validator;
+            }
+
+            void prefetch(xcb_connection_t *connection, xcb_window_t window)
+            {
+                if (m_valid.contains(window) || m_pending.contains(window)) {
+                    return;
+                }
+                Pending &pending = m_pending[window];
+                pending.sequence = xcb_get_window_attributes(connection, window).sequence;
+                pending.sent.start();
+                // send it now, not with the next batch of dialog requests
+                xcb_flush(connection);
+                m_connection = connection;
+                if (!m_pollTimer.isActive()) {
+                    m_pollTimer.start();
+                }
+            }
+
+            // done is called right away if the answer is known, otherwise once it arrives
+            // or the validation times out
+            void validate(xcb_connection_t *connection, xcb_window_t window, const std::function<void(bool)> &done)
+            {
+                if (m_valid.contains(window)) {
+                    done(true);
+                    return;
+                }
+                prefetch(connection, window);
+                m_pending[window].waiters << done;
+                poll();
+            }
+
+            bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override
+            {
+                Q_UNUSED(result)
+                if (eventType == "xcb_generic_event_t") {
+                    auto event = static_cast<xcb_generic_event_t *>(message);
+                    if ((event->response_type & ~0x80) == XCB_DESTROY_NOTIFY) {
+                        m_valid.remove(reinterpret_cast<xcb_destroy_notify_event_t *>(event)->window);
+                    }
+                }
+                return false;
+            }
+
+        private:
+            struct Pending
+            {
+                unsigned int sequence = 0;
+                QElapsedTimer sent;
+                QList<std::function<void(bool)>> waiters;
+            };
+
+            X11Validator()
+            {
+                m_pollTimer.setInterval(PollInterval);
+                QObject::connect(&m_pollTimer, &QTimer::timeout, [this] { poll(); });
+            }
+
+            // Qt's event reader thread moves replies into xcb's queue; this only looks
+            // whether ours are there and never waits for them
+            void poll()
+            {
+                QList<QPair<xcb_window_t, bool>> answered;
+                for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+                    void *reply = nullptr;
+                    xcb_generic_error_t *error = nullptr;
+                    if (xcb_poll_for_reply(m_connection, it->sequence, &reply, &error)) {
+                        answered << qMakePair(it.key(), reply != nullptr);
+                        free(reply);
+                        free(error);
+                    } else if (it->sent.hasExpired(ParentWindow::ValidationTimeout)) {
+                        xcb_discard_reply(m_connection, it->sequence);
+                        qCDebug(XdgDesktopPortalLxqtParent) << "No answer for parent window" << Qt::hex << it.key() << "in time";
+                        answered << qMakePair(it.key(), false);
+                    }
+                }
+                for (const auto &answer : answered) {
+                    finish(answer.first, answer.second);
+                }
+                if (m_pending.isEmpty()) {
+                    m_pollTimer.stop();
+                }
+            }
+
+            void finish(xcb_window_t window, bool valid)
+            {
+                const QList<std::function<void(bool)>> waiters = m_pending.take(window).waiters;
+                if (!valid) {
+                    qCDebug(XdgDesktopPortalLxqtParent) << "Parent window" << Qt::hex << window << "is not usable";
+                } else {
+                    // learn about its destruction; our client's event mask on a foreign
+                    // window doesn't affect anybody else
+                    const uint32_t mask = XCB_EVENT_MASK_STRUCTURE_NOTIFY;
+                    xcb_change_window_attributes(m_connection, window, XCB_CW_EVENT_MASK, &mask);
+                    xcb_flush(m_connection);
+                    if (m_valid.isEmpty()) {
+                        QCoreApplication::instance()->installNativeEventFilter(this);
+                    }
+                    m_valid.insert(window);
+                }
+                for (const auto &done : waiters) {
+                    done(valid);
+                }
+            }
+
+        private:
+            // how often outstanding replies are looked for, in ms
+            static constexpr int PollInterval = 5;
+
+            xcb_connection_t *m_connection = nullptr;
+            QSet<xcb_window_t> m_valid;
+            // outstanding GetWindowAttributes requests
+            QHash<xcb_window_t, Pending> m_pending;
+            QTimer m_pollTimer;
+        };
+#endif
+    }
+
+    /*static*/ void ParentWindow::prefetch(const QString &parent_window)
+    {
+#ifdef HAVE_XCB
+        if (isX11Handle(parent_window)) {
+            if (auto connection = xcbConnection()) {
+                X11Validator::instance().prefetch(connection, x11Window(parent_window));
+            }
+        }
+#else
+        Q_UNUSED(parent_window)
+#endif
+    }
+
+    /*static*/ void ParentWindow::apply(QWidget *w, const QString &parent_window)
+    {
+        if (isX11Handle(parent_window)) {
+            const WId window = x11Window(parent_window);
+            w->setAttribute(Qt::WA_NativeWindow, true);
+#ifdef HAVE_XCB
+            if (auto connection = xcbConnection()) {
+                // Usually answered while the dialog was built. Otherwise the dialog is shown
+                // unparented and becomes transient for the window once the reply arrives.
+                const QPointer<QWidget> widget{w};
+                X11Validator::instance().validate(connection, window, [widget, window](bool valid) {
+                    if (widget && valid) {
+                        KWindowSystem::setMainWindow(widget->windowHandle(), window);
+                    }
+                });
+                return;
+            }
+#endif
+            KWindowSystem::setMainWindow(w->windowHandle(), window);
+        }
+        if (parent_window.startsWith((QLatin1String("wayland:")))) {
+            if (!w->window()->windowHandle()) {
+                w->window()->winId(); // create QWindow
+            }
+            KWindowSystem::setMainWindow(w->window()->windowHandle(), parent_window.mid(strlen("wayland:")));
+        }
+    }
+}
+
+void Utils::setParentWindow(QWidget *w, const QString &parent_window)
+{
+    LXQt::ParentWindow::apply(w, parent_window);
+}
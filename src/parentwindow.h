@@ -0,0 +1,54 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QString>
+
+class QWidget;
+
+namespace LXQt
+{
+    // Resolves the parent_window handle of a request while the dialog is being built.
+    // For "x11:" handles the window is validated with a GetWindowAttributes request sent
+    // as soon as the request arrives, so on a remote X server the round trip overlaps
+    // dialog construction. The GUI thread never waits for the reply: the event loop looks
+    // for it, and a dialog shown before it arrived is made transient afterwards.
+    // Valid windows are cached per handle until their DestroyNotify arrives; a window that
+    // doesn't exist (anymore) or doesn't answer in time leaves the dialog unparented.
+    // Other handle types are applied as before.
+    class ParentWindow
+    {
+    public:
+        // how long a validation may take before the window counts as invalid
+        static constexpr int ValidationTimeout = 250;
+
+        // starts validating parent_window, returns immediately
+        static void prefetch(const QString &parent_window);
+
+        // makes w transient for parent_window, see Utils::setParentWindow()
+        static void apply(QWidget *w, const QString &parent_window);
+    };
+}
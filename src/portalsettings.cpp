@@ -0,0 +1,66 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "portalsettings.h"
+
+#include <QSettings>
+
+namespace LXQt
+{
+    /*static*/ const PortalSettings &PortalSettings::instance()
+    {
+        static const PortalSettings settings;
+        return settings;
+    }
+
+    PortalSettings::PortalSettings()
+    {
+        QSettings settings{QSettings::IniFormat, QSettings::UserScope, QStringLiteral("lxqt"), QStringLiteral("xdg-desktop-portal-lxqt")};
+        settings.beginGroup(QStringLiteral("FileDialog"));
+        m_lazyPlaces = settings.value(QStringLiteral("LazyPlaces"), m_lazyPlaces).toBool();
+        m_dialogWorkers = settings.value(QStringLiteral("DialogWorkers"), m_dialogWorkers).toBool();
+        if (settings.value(QStringLiteral("DuplicateRequests")).toString() == QLatin1String("cancel-earlier")) {
+            m_duplicateRequests = CancelEarlier;
+        }
+        m_folderCacheSize = qMax(0, settings.value(QStringLiteral("FolderCacheSize"), m_folderCacheSize).toInt());
+        m_thumbnailThreads = qMax(0, settings.value(QStringLiteral("ThumbnailThreads"), m_thumbnailThreads).toInt());
+        settings.endGroup();
+
+        settings.beginGroup(QStringLiteral("Access"));
+        m_accessBatchWindow = qMax(0, settings.value(QStringLiteral("BatchWindow"), m_accessBatchWindow).toInt());
+        settings.endGroup();
+
+        settings.beginGroup(QStringLiteral("Notification"));
+        m_notificationBatchWindow = qMax(0, settings.value(QStringLiteral("BatchWindow"), m_notificationBatchWindow).toInt());
+        settings.endGroup();
+
+        settings.beginGroup(QStringLiteral("Wallpaper"));
+        const QString helper = settings.value(QStringLiteral("Helper")).toString();
+        if (!helper.isEmpty()) {
+            m_wallpaperHelper = helper;
+        }
+        settings.endGroup();
+    }
+}
@@ -0,0 +1,103 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QString>
+
+namespace LXQt
+{
+    // Deployment switches, read once from lxqt/xdg-desktop-portal-lxqt.conf in the XDG config
+    // dirs (~/.config first, then e.g. /etc/xdg), so administrators can set defaults for all
+    // users:
+    //
+    //   [FileDialog]
+    //   LazyPlaces=true
+    //   DialogWorkers=true
+    //   DuplicateRequests=cancel-earlier
+    //   FolderCacheSize=32
+    //   ThumbnailThreads=2
+    //
+    //   [Access]
+    //   BatchWindow=250
+    //
+    //   [Notification]
+    //   BatchWindow=15
+    //
+    //   [Wallpaper]
+    //   Helper=pcmanfm-qt
+    //
+    // Environment variables are only used for the hooks of the developer tools (tracing and
+    // automatic responses), not for settings.
+    class PortalSettings
+    {
+    public:
+        enum DuplicateRequests {
+            // every call attached to a dialog gets its result
+            ShareResult,
+            // only the latest one does, the earlier ones are cancelled, including the call
+            // that opened the dialog the user worked in
+            CancelEarlier
+        };
+
+        static const PortalSettings &instance();
+
+        // show automount and network places from cached metadata, resolve them on click
+        bool lazyPlaces() const { return m_lazyPlaces; }
+
+        // run OpenFile/SaveFile dialogs in short-lived worker processes
+        bool dialogWorkers() const { return m_dialogWorkers; }
+
+        // how duplicate OpenFile/SaveFile calls attached to an open dialog are answered
+        DuplicateRequests duplicateRequests() const { return m_duplicateRequests; }
+
+        // collect access prompts arriving within this many ms into one dialog, 0 is off
+        int accessBatchWindow() const { return m_accessBatchWindow; }
+
+        // MiB of folder listings kept between requests, 0 is off
+        int folderCacheSize() const { return m_folderCacheSize; }
+
+        // threads generating thumbnails, 0 picks one from the number of cores
+        int thumbnailThreads() const { return m_thumbnailThreads; }
+
+        // updates of the same notification within this many ms are sent once, 0 is off
+        int notificationBatchWindow() const { return m_notificationBatchWindow; }
+
+        // program called with pcmanfm-qt's --set-wallpaper arguments
+        QString wallpaperHelper() const { return m_wallpaperHelper; }
+
+    private:
+        PortalSettings();
+
+        bool m_lazyPlaces = false;
+        bool m_dialogWorkers = false;
+        DuplicateRequests m_duplicateRequests = ShareResult;
+        int m_accessBatchWindow = 0;
+        int m_folderCacheSize = 32;
+        int m_thumbnailThreads = 0;
+        int m_notificationBatchWindow = 15;
+        QString m_wallpaperHelper = QStringLiteral("pcmanfm-qt");
+    };
+}
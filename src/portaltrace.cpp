@@ -0,0 +1,443 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "portaltrace.h"
+#include "choices.h"
+#include "filters.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDBusSignature>
+#include <QDBusVariant>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtTrace, "xdp-lxqt-trace")
+
+    static const char TraceMagic[] = "XLPTRACE";
+    static const quint16 TraceVersion = 1;
+
+    static QVariant plainValue(const QVariant &value, QString &signature);
+
+    static QVariant filterListToTree(const FilterList &filterList)
+    {
+        QVariantList filters;
+        for (const Filter &filter : filterList.filters) {
+            filters << QVariant{QVariantList{filter.type, filter.filterString}};
+        }
+        return QVariantList{filterList.userVisibleName, filters};
+    }
+
+    // Converts the current element of a complex D-Bus argument into a tree of plain values.
+    static QVariant demarshal(const QDBusArgument &arg)
+    {
+        switch (arg.currentType()) {
+        case QDBusArgument::ArrayType: {
+            if (arg.currentSignature() == QLatin1String("ay")) {
+                QByteArray bytes;
+                arg >> bytes;
+                return bytes;
+            }
+            QVariantList list;
+            arg.beginArray();
+            while (!arg.atEnd()) {
+                list << demarshal(arg);
+            }
+            arg.endArray();
+            return list;
+        }
+        case QDBusArgument::StructureType: {
+            QVariantList fields;
+            arg.beginStructure();
+            while (!arg.atEnd()) {
+                fields << demarshal(arg);
+            }
+            arg.endStructure();
+            return fields;
+        }
+        case QDBusArgument::MapType: {
+            // keys need not be strings, so store entries as [key, value] pairs
+            QVariantList entries;
+            arg.beginMap();
+            while (!arg.atEnd()) {
+                arg.beginMapEntry();
+                const QVariant key = demarshal(arg);
+                const QVariant value = demarshal(arg);
+                arg.endMapEntry();
+                entries << QVariant{QVariantList{key, value}};
+            }
+            arg.endMap();
+            return entries;
+        }
+        default: {
+            QString signature;
+            return plainValue(arg.asVariant(), signature);
+        }
+        }
+    }
+
+    static QVariant plainValue(const QVariant &value, QString &signature)
+    {
+        if (value.userType() == qMetaTypeId<QDBusArgument>()) {
+            const QDBusArgument arg = value.value<QDBusArgument>();
+            signature = arg.currentSignature();
+            return demarshal(arg);
+        }
+        if (value.userType() == qMetaTypeId<QDBusVariant>()) {
+            QString innerSignature;
+            return plainValue(value.value<QDBusVariant>().variant(), innerSignature);
+        }
+        if (value.userType() == qMetaTypeId<QDBusObjectPath>()) {
+            signature = QStringLiteral("o");
+            return value.value<QDBusObjectPath>().path();
+        }
+        if (value.userType() == qMetaTypeId<QDBusSignature>()) {
+            signature = QStringLiteral("g");
+            return value.value<QDBusSignature>().signature();
+        }
+        // results of the portal's own dialogs carry these unmarshalled
+        if (value.userType() == qMetaTypeId<FilterList>()) {
+            signature = QStringLiteral("(sa(us))");
+            return filterListToTree(value.value<FilterList>());
+        }
+        if (value.userType() == qMetaTypeId<Choices>()) {
+            signature = QStringLiteral("a(ss)");
+            QVariantList list;
+            const Choices choices = value.value<Choices>();
+            for (const Choice &choice : choices) {
+                list << QVariant{QVariantList{choice.id, choice.value}};
+            }
+            return list;
+        }
+        return value;
+    }
+
+    static Filter filterFromTree(const QVariant &tree)
+    {
+        const QVariantList fields = tree.toList();
+        return {fields.value(0).toUInt(), fields.value(1).toString()};
+    }
+
+    static FilterList filterListFromTree(const QVariant &tree)
+    {
+        const QVariantList fields = tree.toList();
+        FilterList filterList;
+        filterList.userVisibleName = fields.value(0).toString();
+        const QVariantList filters = fields.value(1).toList();
+        for (const QVariant &filter : filters) {
+            filterList.filters << filterFromTree(filter);
+        }
+        return filterList;
+    }
+
+    static Choice choiceFromTree(const QVariant &tree)
+    {
+        const QVariantList fields = tree.toList();
+        return {fields.value(0).toString(), fields.value(1).toString()};
+    }
+
+    static Option optionFromTree(const QVariant &tree)
+    {
+        const QVariantList fields = tree.toList();
+        Option option;
+        option.id = fields.value(0).toString();
+        option.label = fields.value(1).toString();
+        const QVariantList choices = fields.value(2).toList();
+        for (const QVariant &choice : choices) {
+            option.choices << choiceFromTree(choice);
+        }
+        option.initialChoiceId = fields.value(3).toString();
+        return option;
+    }
+
+    // Turns a recorded value back into something QtDBus marshals with the original signature.
+    static QVariant rebuildValue(const QString &signature, const QVariant &tree, bool &ok)
+    {
+        ok = true;
+        if (signature == QLatin1String("o")) {
+            return QVariant::fromValue(QDBusObjectPath{tree.toString()});
+        }
+        if (signature == QLatin1String("g")) {
+            return QVariant::fromValue(QDBusSignature{tree.toString()});
+        }
+        if (signature == QLatin1String("(sa(us))")) {
+            return QVariant::fromValue(filterListFromTree(tree));
+        }
+        if (signature == QLatin1String("a(sa(us))")) {
+            FilterListList filterListList;
+            const QVariantList list = tree.toList();
+            for (const QVariant &filterList : list) {
+                filterListList << filterListFromTree(filterList);
+            }
+            return QVariant::fromValue(filterListList);
+        }
+        if (signature == QLatin1String("a(ss)")) {
+            Choices choices;
+            const QVariantList list = tree.toList();
+            for (const QVariant &choice : list) {
+                choices << choiceFromTree(choice);
+            }
+            return QVariant::fromValue(choices);
+        }
+        if (signature == QLatin1String("a(ssa(ss)s)")) {
+            OptionList optionList;
+            const QVariantList list = tree.toList();
+            for (const QVariant &option : list) {
+                optionList << optionFromTree(option);
+            }
+            return QVariant::fromValue(optionList);
+        }
+        ok = false;
+        return QVariant{};
+    }
+
+    QByteArray TraceRecord::serialize() const
+    {
+        QByteArray payload;
+        QDataStream stream{&payload, QIODevice::WriteOnly};
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << method.toUtf8() << static_cast<quint8>(arguments.size());
+        for (const QString &argument : arguments) {
+            stream << argument.toUtf8();
+        }
+        stream << static_cast<quint32>(options.size());
+        for (auto it = options.cbegin(); it != options.cend(); ++it) {
+            stream << it.key().toUtf8() << signatures.value(it.key()).toUtf8() << it.value();
+        }
+        return payload;
+    }
+
+    bool TraceRecord::deserialize(const QByteArray &payload)
+    {
+        QDataStream in{payload};
+        in.setVersion(QDataStream::Qt_6_0);
+        QByteArray methodName;
+        quint8 argumentCount = 0;
+        in >> methodName >> argumentCount;
+        method = QString::fromUtf8(methodName);
+        arguments.clear();
+        for (int i = 0; i < argumentCount; ++i) {
+            QByteArray argument;
+            in >> argument;
+            arguments << QString::fromUtf8(argument);
+        }
+        quint32 optionCount = 0;
+        in >> optionCount;
+        options.clear();
+        signatures.clear();
+        for (quint32 i = 0; i < optionCount && in.status() == QDataStream::Ok; ++i) {
+            QByteArray key;
+            QByteArray signature;
+            QVariant value;
+            in >> key >> signature >> value;
+            options.insert(QString::fromUtf8(key), value);
+            if (!signature.isEmpty()) {
+                signatures.insert(QString::fromUtf8(key), QString::fromUtf8(signature));
+            }
+        }
+        return in.status() == QDataStream::Ok;
+    }
+
+    QVariantMap TraceRecord::dbusOptions(int *skipped) const
+    {
+        QVariantMap result;
+        for (auto it = options.cbegin(); it != options.cend(); ++it) {
+            const QString signature = signatures.value(it.key());
+            if (signature.isEmpty()) {
+                result.insert(it.key(), it.value());
+                continue;
+            }
+            bool ok = false;
+            const QVariant value = rebuildValue(signature, it.value(), ok);
+            if (ok) {
+                result.insert(it.key(), value);
+            } else if (skipped) {
+                ++*skipped;
+            }
+        }
+        return result;
+    }
+
+    TraceRecorder *TraceRecorder::instance()
+    {
+        static const QString fileName = qEnvironmentVariable("XDG_DESKTOP_PORTAL_LXQT_TRACE");
+        if (fileName.isEmpty()) {
+            return nullptr;
+        }
+        static TraceRecorder recorder{fileName, qEnvironmentVariableIntValue("XDG_DESKTOP_PORTAL_LXQT_TRACE_ANONYMIZE") != 0};
+        return recorder.m_file.isOpen() ? &recorder : nullptr;
+    }
+
+    TraceRecorder::TraceRecorder(const QString &fileName, bool anonymize)
+        : m_file{fileName}
+        , m_anonymize{anonymize}
+    {
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCWarning(XdgDesktopPortalLxqtTrace) << "Cannot open trace file" << fileName << m_file.errorString();
+            return;
+        }
+        QDataStream stream{&m_file};
+        stream.writeRawData(TraceMagic, sizeof(TraceMagic) - 1);
+        stream << TraceVersion;
+        m_file.flush();
+
+        if (m_anonymize) {
+            m_salt = QByteArray::number(QRandomGenerator::system()->generate64(), 16);
+        }
+        m_clock.start();
+        qCDebug(XdgDesktopPortalLxqtTrace) << "Recording portal calls to" << fileName << (m_anonymize ? "(anonymized)" : "");
+    }
+
+    TraceRecord TraceRecorder::toRecord(const QString &method, const QStringList &arguments, const QVariantMap &options)
+    {
+        TraceRecord record;
+        record.method = method;
+        record.arguments = arguments;
+        for (auto it = options.cbegin(); it != options.cend(); ++it) {
+            QString signature;
+            record.options.insert(it.key(), plainValue(it.value(), signature));
+            if (!signature.isEmpty()) {
+                record.signatures.insert(it.key(), signature);
+            }
+        }
+        return record;
+    }
+
+    QByteArray TraceRecorder::anonymizePath(const QByteArray &path)
+    {
+        QByteArray result;
+        result.reserve(path.size());
+        const QList<QByteArray> components = path.split('/');
+        for (int i = 0; i < components.size(); ++i) {
+            const QByteArray &component = components.at(i);
+            if (i > 0) {
+                result += '/';
+            }
+            if (component.isEmpty() || component == "." || component == "..") {
+                result += component;
+                continue;
+            }
+            auto it = m_anonymized.constFind(component);
+            if (it == m_anonymized.cend()) {
+                // keep a short extension, it matters for filters and MIME detection
+                const int dot = component.lastIndexOf('.');
+                const bool keepSuffix = dot > 0 && component.size() - dot <= 8;
+                const QByteArray stem = keepSuffix ? component.left(dot) : component;
+                const QByteArray hash = QCryptographicHash::hash(m_salt + component, QCryptographicHash::Sha1).toHex();
+                QByteArray anonymized;
+                anonymized.reserve(component.size());
+                while (anonymized.size() < stem.size()) {
+                    anonymized += hash.left(stem.size() - anonymized.size());
+                }
+                if (keepSuffix) {
+                    anonymized += component.mid(dot);
+                }
+                it = m_anonymized.insert(component, anonymized);
+            }
+            result += it.value();
+        }
+        return result;
+    }
+
+    void TraceRecorder::record(const QString &method, const QStringList &arguments, const QVariantMap &options)
+    {
+        TraceRecord record = toRecord(method, arguments, options);
+        record.msecs = m_clock.elapsed();
+
+        if (m_anonymize) {
+            for (const QString &key : {QStringLiteral("current_folder"), QStringLiteral("current_file")}) {
+                if (record.options.contains(key)) {
+                    QByteArray path = record.options.value(key).toByteArray();
+                    int nulls = 0;
+                    while (path.endsWith('\0')) {
+                        path.chop(1);
+                        ++nulls;
+                    }
+                    record.options.insert(key, anonymizePath(path) + QByteArray(nulls, '\0'));
+                }
+            }
+            if (record.options.contains(QStringLiteral("current_name"))) {
+                const QString name = record.options.value(QStringLiteral("current_name")).toString();
+                record.options.insert(QStringLiteral("current_name"), QString::fromUtf8(anonymizePath(name.toUtf8())));
+            }
+        }
+
+        const QByteArray payload = record.serialize();
+
+        QDataStream stream{&m_file};
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << record.msecs << qCompress(payload, 1);
+        m_file.flush();
+    }
+
+    TraceReader::TraceReader(const QString &fileName)
+        : m_file{fileName}
+    {
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            m_error = m_file.errorString();
+            return;
+        }
+        QDataStream stream{&m_file};
+        char magic[sizeof(TraceMagic) - 1];
+        quint16 version = 0;
+        if (stream.readRawData(magic, sizeof(magic)) != sizeof(magic) || qstrncmp(magic, TraceMagic, sizeof(magic)) != 0) {
+            m_error = QStringLiteral("not a portal trace file");
+            return;
+        }
+        stream >> version;
+        if (version != TraceVersion) {
+            m_error = QStringLiteral("unsupported trace version %1").arg(version);
+            return;
+        }
+        m_valid = true;
+    }
+
+    bool TraceReader::next(TraceRecord &record)
+    {
+        if (!m_valid || m_file.atEnd()) {
+            return false;
+        }
+
+        QDataStream stream{&m_file};
+        stream.setVersion(QDataStream::Qt_6_0);
+        QByteArray compressed;
+        stream >> record.msecs >> compressed;
+        const QByteArray payload = qUncompress(compressed);
+        if (stream.status() != QDataStream::Ok || payload.isEmpty()) {
+            m_error = QStringLiteral("corrupted record");
+            return false;
+        }
+
+        if (!record.deserialize(payload)) {
+            m_error = QStringLiteral("corrupted record");
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <memory>
+
+namespace LXQt
+{
+    // One recorded portal call. Option values which were complex D-Bus types are stored
+    // as plain trees (structures and arrays as QVariantList) together with their D-Bus
+    // signature, so the trace doesn't depend on the portal's own C++ types.
+    struct TraceRecord {
+        qint64 msecs = 0;
+        QString method;
+        // string arguments following the request handle: app_id, parent_window, title[, subtitle, body]
+        QStringList arguments;
+        QVariantMap options;
+        QMap<QString, QString> signatures;
+
+        // the compact form stored in trace files and sent to dialog workers
+        QByteArray serialize() const;
+        bool deserialize(const QByteArray &payload);
+
+        // options with the recorded signatures turned back into types QtDBus marshals with
+        // that signature; values with an unsupported signature are left out and counted
+        QVariantMap dbusOptions(int *skipped = nullptr) const;
+    };
+
+    // Opt-in recorder of incoming OpenFile/SaveFile/AccessDialog calls. Enabled by setting
+    // XDG_DESKTOP_PORTAL_LXQT_TRACE to the trace file; XDG_DESKTOP_PORTAL_LXQT_TRACE_ANONYMIZE=1
+    // replaces every path component by a salted hash of the same length.
+    class TraceRecorder
+    {
+    public:
+        // nullptr when recording is not enabled
+        static TraceRecorder *instance();
+
+        void record(const QString &method, const QStringList &arguments, const QVariantMap &options);
+
+        static TraceRecord toRecord(const QString &method, const QStringList &arguments, const QVariantMap &options);
+
+    private:
+        TraceRecorder(const QString &fileName, bool anonymize);
+        QByteArray anonymizePath(const QByteArray &path);
+
+        QFile m_file;
+        QElapsedTimer m_clock;
+        bool m_anonymize;
+        QByteArray m_salt;
+        QHash<QByteArray, QByteArray> m_anonymized;
+    };
+
+    class TraceReader
+    {
+    public:
+        explicit TraceReader(const QString &fileName);
+
+        bool isValid() const { return m_valid; }
+        QString errorString() const { return m_error; }
+        // returns false at the end of the trace or on a corrupted record
+        bool next(TraceRecord &record);
+
+    private:
+        QFile m_file;
+        bool m_valid = false;
+        QString m_error;
+    };
+}
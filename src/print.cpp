@@ -0,0 +1,377 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "print.h"
+#include "parentwindow.h"
+#include "printspool.h"
+#include "utils.h"
+
+#include <QDBusObjectPath>
+#include <QDBusUnixFileDescriptor>
+#include <QEventLoop>
+#include <QLoggingCategory>
+#include <QPageLayout>
+#include <QPageRanges>
+#include <QPrintDialog>
+#include <QPrinter>
+#include <QThread>
+#include <QUrl>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtPrint, "xdp-lxqt-print")
+
+    // The frontend passes GtkPrintSettings and GtkPageSetup as string dictionaries;
+    // only the keys that map onto QPrinter and lp(1) are handled.
+
+    static QString settingValue(const QVariantMap &settings, const char *key)
+    {
+        return settings.value(QLatin1String(key)).toString();
+    }
+
+    static QString localOutputFile(const QVariantMap &settings)
+    {
+        const QUrl uri{settingValue(settings, "output-uri")};
+        return uri.isLocalFile() ? uri.toLocalFile() : QString();
+    }
+
+    // GTK page ranges are zero based ("0-3,5"), QPageRanges and lp one based
+    static QPageRanges pageRangesFromGtk(const QString &ranges)
+    {
+        QPageRanges pageRanges;
+        const QStringList parts = ranges.split(QLatin1Char(','), Qt::SkipEmptyParts);
+        for (const QString &part : parts) {
+            bool fromOk = false;
+            bool toOk = true;
+            const int from = part.section(QLatin1Char('-'), 0, 0).trimmed().toInt(&fromOk);
+            const int to = part.contains(QLatin1Char('-')) ? part.section(QLatin1Char('-'), 1, 1).trimmed().toInt(&toOk) : from;
+            if (fromOk && toOk && from >= 0 && to >= from) {
+                pageRanges.addRange(from + 1, to + 1);
+            }
+        }
+        return pageRanges;
+    }
+
+    static QString pageRangesToGtk(const QPageRanges &pageRanges)
+    {
+        QStringList parts;
+        const auto ranges = pageRanges.toRangeList();
+        for (const QPageRanges::Range &range : ranges) {
+            parts << (range.from == range.to ? QString::number(range.from - 1)
+                                             : QStringLiteral("%1-%2").arg(range.from - 1).arg(range.to - 1));
+        }
+        return parts.join(QLatin1Char(','));
+    }
+
+    static void applySettings(QPrinter &printer, const QVariantMap &settings, const QVariantMap &pageSetup)
+    {
+        const QString outputFile = localOutputFile(settings);
+        if (!outputFile.isEmpty()) {
+            printer.setOutputFileName(outputFile);
+        } else if (settings.contains(QStringLiteral("printer"))) {
+            printer.setPrinterName(settingValue(settings, "printer"));
+        }
+
+        const int copies = settingValue(settings, "n-copies").toInt();
+        if (copies > 0) {
+            printer.setCopyCount(copies);
+        }
+        if (settings.contains(QStringLiteral("collate"))) {
+            printer.setCollateCopies(settingValue(settings, "collate") == QLatin1String("true"));
+        }
+        if (settings.contains(QStringLiteral("reverse"))) {
+            printer.setPageOrder(settingValue(settings, "reverse") == QLatin1String("true") ? QPrinter::LastPageFirst : QPrinter::FirstPageFirst);
+        }
+        if (settings.contains(QStringLiteral("use-color"))) {
+            printer.setColorMode(settingValue(settings, "use-color") == QLatin1String("false") ? QPrinter::GrayScale : QPrinter::Color);
+        }
+        const QString duplex = settingValue(settings, "duplex");
+        if (duplex == QLatin1String("horizontal")) {
+            printer.setDuplex(QPrinter::DuplexShortSide);
+        } else if (duplex == QLatin1String("vertical")) {
+            printer.setDuplex(QPrinter::DuplexLongSide);
+        } else if (duplex == QLatin1String("simplex")) {
+            printer.setDuplex(QPrinter::DuplexNone);
+        }
+        const QString ranges = settingValue(settings, "page-ranges");
+        if (!ranges.isEmpty()) {
+            printer.setPageRanges(pageRangesFromGtk(ranges));
+            printer.setPrintRange(QPrinter::PageRange);
+        }
+
+        const QString orientation = settingValue(pageSetup, "Orientation").isEmpty() ? settingValue(settings, "orientation") : settingValue(pageSetup, "Orientation");
+        if (orientation.endsWith(QLatin1String("landscape"))) {
+            printer.setPageOrientation(QPageLayout::Landscape);
+        } else if (orientation.endsWith(QLatin1String("portrait"))) {
+            printer.setPageOrientation(QPageLayout::Portrait);
+        }
+        const qreal width = pageSetup.value(QStringLiteral("Width")).toDouble();
+        const qreal height = pageSetup.value(QStringLiteral("Height")).toDouble();
+        if (width > 0 && height > 0) {
+            printer.setPageSize(QPageSize{QSizeF{width, height}, QPageSize::Millimeter, settingValue(pageSetup, "DisplayName")});
+        }
+        if (pageSetup.contains(QStringLiteral("MarginTop"))) {
+            printer.setPageMargins(QMarginsF{pageSetup.value(QStringLiteral("MarginLeft")).toDouble(),
+                                       pageSetup.value(QStringLiteral("MarginTop")).toDouble(),
+                                       pageSetup.value(QStringLiteral("MarginRight")).toDouble(),
+                                       pageSetup.value(QStringLiteral("MarginBottom")).toDouble()},
+                    QPageLayout::Millimeter);
+        }
+    }
+
+    static QVariantMap settingsFromPrinter(const QPrinter &printer)
+    {
+        QVariantMap settings;
+        if (printer.outputFormat() == QPrinter::PdfFormat) {
+            settings.insert(QStringLiteral("output-uri"), QUrl::fromLocalFile(printer.outputFileName()).toString());
+            settings.insert(QStringLiteral("output-file-format"), QStringLiteral("pdf"));
+        } else {
+            settings.insert(QStringLiteral("printer"), printer.printerName());
+        }
+        settings.insert(QStringLiteral("n-copies"), QString::number(printer.copyCount()));
+        settings.insert(QStringLiteral("collate"), printer.collateCopies() ? QStringLiteral("true") : QStringLiteral("false"));
+        settings.insert(QStringLiteral("reverse"), printer.pageOrder() == QPrinter::LastPageFirst ? QStringLiteral("true") : QStringLiteral("false"));
+        settings.insert(QStringLiteral("use-color"), printer.colorMode() == QPrinter::Color ? QStringLiteral("true") : QStringLiteral("false"));
+        switch (printer.duplex()) {
+        case QPrinter::DuplexLongSide:
+            settings.insert(QStringLiteral("duplex"), QStringLiteral("vertical"));
+            break;
+        case QPrinter::DuplexShortSide:
+            settings.insert(QStringLiteral("duplex"), QStringLiteral("horizontal"));
+            break;
+        default:
+            settings.insert(QStringLiteral("duplex"), QStringLiteral("simplex"));
+            break;
+        }
+        if (printer.printRange() == QPrinter::PageRange && !printer.pageRanges().isEmpty()) {
+            settings.insert(QStringLiteral("print-pages"), QStringLiteral("ranges"));
+            settings.insert(QStringLiteral("page-ranges"), pageRangesToGtk(printer.pageRanges()));
+        } else {
+            settings.insert(QStringLiteral("print-pages"), QStringLiteral("all"));
+        }
+        settings.insert(QStringLiteral("orientation"), printer.pageLayout().orientation() == QPageLayout::Landscape ? QStringLiteral("landscape") : QStringLiteral("portrait"));
+        return settings;
+    }
+
+    static QVariantMap pageSetupFromPrinter(const QPrinter &printer)
+    {
+        const QPageLayout layout = printer.pageLayout();
+        const QSizeF size = layout.pageSize().size(QPageSize::Millimeter);
+        const QMarginsF margins = layout.margins(QPageLayout::Millimeter);
+        return {
+            {QStringLiteral("PPDName"), layout.pageSize().key()},
+            {QStringLiteral("Name"), layout.pageSize().key()},
+            {QStringLiteral("DisplayName"), layout.pageSize().name()},
+            {QStringLiteral("Width"), size.width()},
+            {QStringLiteral("Height"), size.height()},
+            {QStringLiteral("MarginTop"), margins.top()},
+            {QStringLiteral("MarginBottom"), margins.bottom()},
+            {QStringLiteral("MarginLeft"), margins.left()},
+            {QStringLiteral("MarginRight"), margins.right()},
+            {QStringLiteral("Orientation"), layout.orientation() == QPageLayout::Landscape ? QStringLiteral("landscape") : QStringLiteral("portrait")},
+        };
+    }
+
+    // The document is already laid out, so only job options are passed on. That includes
+    // the page ranges: the app renders only the selected pages, and -P would select again
+    // among those.
+    static QStringList lpArguments(const QVariantMap &settings, const QString &title)
+    {
+        QStringList arguments;
+        const QString printer = settingValue(settings, "printer");
+        if (!printer.isEmpty()) {
+            arguments << QStringLiteral("-d") << printer;
+        }
+        if (!title.isEmpty()) {
+            arguments << QStringLiteral("-t") << title;
+        }
+        const int copies = settingValue(settings, "n-copies").toInt();
+        if (copies > 1) {
+            arguments << QStringLiteral("-n") << QString::number(copies);
+            arguments << QStringLiteral("-o") << (settingValue(settings, "collate") == QLatin1String("true") ? QStringLiteral("collate=true") : QStringLiteral("collate=false"));
+        }
+        const QString duplex = settingValue(settings, "duplex");
+        if (duplex == QLatin1String("vertical")) {
+            arguments << QStringLiteral("-o") << QStringLiteral("sides=two-sided-long-edge");
+        } else if (duplex == QLatin1String("horizontal")) {
+            arguments << QStringLiteral("-o") << QStringLiteral("sides=two-sided-short-edge");
+        }
+        if (settingValue(settings, "reverse") == QLatin1String("true")) {
+            arguments << QStringLiteral("-o") << QStringLiteral("outputorder=reverse");
+        }
+        if (settingValue(settings, "use-color") == QLatin1String("false")) {
+            arguments << QStringLiteral("-o") << QStringLiteral("print-color-mode=monochrome");
+        }
+        return arguments;
+    }
+
+    PrintPortal::PrintPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    bool PrintPortal::execDialog(const QString &parentWindow, const QString &title, bool modal, PreparedJob &job)
+    {
+        QPrinter printer;
+        applySettings(printer, job.settings, job.pageSetup);
+
+        QPrintDialog dialog{&printer};
+        if (!title.isEmpty()) {
+            dialog.setWindowTitle(title);
+        }
+        dialog.setOption(QAbstractPrintDialog::PrintToFile, true);
+        dialog.setOption(QAbstractPrintDialog::PrintPageRange, true);
+        dialog.setOption(QAbstractPrintDialog::PrintCollateCopies, true);
+        dialog.setWindowModality(modal ? Qt::ApplicationModal : Qt::NonModal);
+        Utils::setParentWindow(&dialog, parentWindow);
+
+        QEventLoop loop;
+        QObject::connect(&dialog, &QDialog::finished, &loop, &QEventLoop::quit);
+        dialog.open();
+        Utils::scheduleAutoResponse(&dialog);
+        loop.exec();
+
+        if (dialog.result() != QDialog::Accepted) {
+            return false;
+        }
+        job.settings = settingsFromPrinter(printer);
+        job.pageSetup = pageSetupFromPrinter(printer);
+        return true;
+    }
+
+    uint PrintPortal::Print(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QString &title,
+            const QDBusUnixFileDescriptor &fd,
+            const QVariantMap &options,
+            QVariantMap &results)
+    {
+        Q_UNUSED(results)
+
+        qCDebug(XdgDesktopPortalLxqtPrint) << "Print called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    title: " << title;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    fd: " << fd.fileDescriptor();
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    options: " << options;
+
+        if (!fd.isValid()) {
+            qCWarning(XdgDesktopPortalLxqtPrint) << "Print called without a valid document fd";
+            return 2;
+        }
+
+        ParentWindow::prefetch(parent_window);
+
+        bool modalDialog = true;
+        if (options.contains(QStringLiteral("modal"))) {
+            modalDialog = options.value(QStringLiteral("modal")).toBool();
+        }
+
+        // a matching token means the user already confirmed the settings in PreparePrint
+        PreparedJob job = m_jobs.value(app_id);
+        const uint token = options.value(QStringLiteral("token")).toUInt();
+        const bool prepared = token != 0 && job.token == token;
+        if (!prepared && !execDialog(parent_window, title, modalDialog, job)) {
+            return 1;
+        }
+        job.token = 0;
+        m_jobs.insert(app_id, job);
+
+        // spool on a worker so the portal keeps serving other requests while a large
+        // document is copied
+        const int documentFd = fd.fileDescriptor();
+        const QString outputFile = localOutputFile(job.settings);
+        const QStringList arguments = lpArguments(job.settings, title);
+        bool ok = false;
+        QString error;
+        QThread *spooler = QThread::create([documentFd, outputFile, arguments, &ok, &error] {
+            ok = outputFile.isEmpty() ? PrintSpool::toPrinter(documentFd, arguments, error)
+                                      : PrintSpool::toFile(documentFd, outputFile, error);
+        });
+        QEventLoop loop;
+        QObject::connect(spooler, &QThread::finished, &loop, &QEventLoop::quit);
+        spooler->start();
+        loop.exec();
+        spooler->wait();
+        delete spooler;
+
+        if (!ok) {
+            qCWarning(XdgDesktopPortalLxqtPrint) << "Cannot print" << title << (outputFile.isEmpty() ? QStringLiteral("with lp") : outputFile) << ":" << error;
+            return 2;
+        }
+        return 0;
+    }
+
+    uint PrintPortal::PreparePrint(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QString &title,
+            const QVariantMap &settings,
+            const QVariantMap &page_setup,
+            const QVariantMap &options,
+            QVariantMap &results)
+    {
+        qCDebug(XdgDesktopPortalLxqtPrint) << "PreparePrint called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    title: " << title;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    settings: " << settings;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    page_setup: " << page_setup;
+        qCDebug(XdgDesktopPortalLxqtPrint) << "    options: " << options;
+
+        ParentWindow::prefetch(parent_window);
+
+        bool modalDialog = true;
+        if (options.contains(QStringLiteral("modal"))) {
+            modalDialog = options.value(QStringLiteral("modal")).toBool();
+        }
+
+        // start from what the app used last unless it brings its own settings
+        PreparedJob job = m_jobs.value(app_id);
+        if (!settings.isEmpty()) {
+            job.settings = settings;
+        }
+        if (!page_setup.isEmpty()) {
+            job.pageSetup = page_setup;
+        }
+        if (!execDialog(parent_window, title, modalDialog, job)) {
+            return 1;
+        }
+
+        job.token = ++m_lastToken;
+        if (job.token == 0) {
+            job.token = ++m_lastToken;
+        }
+        m_jobs.insert(app_id, job);
+
+        results.insert(QStringLiteral("settings"), job.settings);
+        results.insert(QStringLiteral("page-setup"), job.pageSetup);
+        results.insert(QStringLiteral("token"), job.token);
+        return 0;
+    }
+}
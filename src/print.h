@@ -0,0 +1,75 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+#include <QHash>
+
+class QDBusObjectPath;
+class QDBusUnixFileDescriptor;
+
+namespace LXQt
+{
+    class PrintPortal : public QDBusAbstractAdaptor
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.impl.portal.Print")
+    public:
+        explicit PrintPortal(QObject *parent);
+
+    public Q_SLOTS:
+        uint Print(const QDBusObjectPath &handle,
+                const QString &app_id,
+                const QString &parent_window,
+                const QString &title,
+                const QDBusUnixFileDescriptor &fd,
+                const QVariantMap &options,
+                QVariantMap &results);
+
+        uint PreparePrint(const QDBusObjectPath &handle,
+                const QString &app_id,
+                const QString &parent_window,
+                const QString &title,
+                const QVariantMap &settings,
+                const QVariantMap &page_setup,
+                const QVariantMap &options,
+                QVariantMap &results);
+
+    private:
+        // what the user picked in PreparePrint, kept per app until the matching Print
+        // and as the starting point for the app's next print dialog
+        struct PreparedJob {
+            uint token = 0;
+            QVariantMap settings;
+            QVariantMap pageSetup;
+        };
+
+        bool execDialog(const QString &parentWindow, const QString &title, bool modal, PreparedJob &job);
+
+        QHash<QString, PreparedJob> m_jobs;
+        uint m_lastToken = 0;
+    };
+}
@@ -0,0 +1,248 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "printspool.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef Q_OS_LINUX
+#include <sys/sendfile.h>
+#endif
+
+#include <vector>
+
+extern char **environ;
+
+namespace LXQt
+{
+    // bytes moved per system call; the kernel does the copying, so this bounds latency, not memory
+    static constexpr size_t ChunkSize = 4 * 1024 * 1024;
+
+    static QString errnoString(const char *call)
+    {
+        return QStringLiteral("%1: %2").arg(QLatin1String(call), QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    // the zero-copy calls report these when they don't support a pair of fds
+    static bool isUnsupported(int error)
+    {
+        return error == EINVAL || error == EXDEV || error == ENOSYS || error == EOPNOTSUPP || error == EBADF;
+    }
+
+    /*static*/ bool PrintSpool::transfer(int in, int out, QString &error)
+    {
+        struct stat inStat;
+        struct stat outStat;
+        if (fstat(in, &inStat) != 0 || fstat(out, &outStat) != 0) {
+            error = errnoString("fstat");
+            return false;
+        }
+        const bool seekable = S_ISREG(inStat.st_mode) || S_ISBLK(inStat.st_mode);
+        off_t offset = 0;
+
+#ifdef Q_OS_LINUX
+        if (seekable && S_ISREG(outStat.st_mode)) {
+            // may even share extents or copy server side on network filesystems
+            for (;;) {
+                const ssize_t n = copy_file_range(in, &offset, out, nullptr, ChunkSize, 0);
+                if (n > 0) {
+                    continue;
+                }
+                if (n == 0) {
+                    return true;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (!isUnsupported(errno)) {
+                    error = errnoString("copy_file_range");
+                    return false;
+                }
+                break;
+            }
+        }
+
+        if (S_ISFIFO(outStat.st_mode)) {
+            for (;;) {
+                const ssize_t n = splice(in, seekable ? &offset : nullptr, out, nullptr, ChunkSize, SPLICE_F_MOVE | SPLICE_F_MORE);
+                if (n > 0) {
+                    continue;
+                }
+                if (n == 0) {
+                    return true;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (!isUnsupported(errno)) {
+                    error = errnoString("splice");
+                    return false;
+                }
+                break;
+            }
+        }
+
+        if (seekable) {
+            for (;;) {
+                const ssize_t n = sendfile(out, in, &offset, ChunkSize);
+                if (n > 0) {
+                    continue;
+                }
+                if (n == 0) {
+                    return true;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (!isUnsupported(errno)) {
+                    error = errnoString("sendfile");
+                    return false;
+                }
+                break;
+            }
+        }
+#endif
+
+        // plain copy through a fixed buffer, continuing where the calls above stopped
+        std::vector<char> buffer(64 * 1024);
+        for (;;) {
+            const ssize_t n = seekable ? pread(in, buffer.data(), buffer.size(), offset) : read(in, buffer.data(), buffer.size());
+            if (n == 0) {
+                return true;
+            }
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = errnoString("read");
+                return false;
+            }
+            offset += n;
+            ssize_t written = 0;
+            while (written < n) {
+                const ssize_t w = write(out, buffer.data() + written, n - written);
+                if (w < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    error = errnoString("write");
+                    return false;
+                }
+                written += w;
+            }
+        }
+    }
+
+    /*static*/ bool PrintSpool::toFile(int documentFd, const QString &path, QString &error)
+    {
+        const int out = open(QFile::encodeName(path).constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (out < 0) {
+            error = errnoString("open");
+            return false;
+        }
+        bool ok = transfer(documentFd, out, error);
+        if (close(out) != 0 && ok) {
+            error = errnoString("close");
+            ok = false;
+        }
+        return ok;
+    }
+
+    /*static*/ bool PrintSpool::toPrinter(int documentFd, const QStringList &lpArguments, QString &error)
+    {
+        int pipeFds[2];
+        if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+            error = errnoString("pipe2");
+            return false;
+        }
+
+        // a spooler that exits early must not take the portal down with SIGPIPE; the write
+        // side reports EPIPE instead
+        sigset_t sigpipe;
+        sigset_t previousMask;
+        sigemptyset(&sigpipe);
+        sigaddset(&sigpipe, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigpipe, &previousMask);
+
+        QList<QByteArray> arguments{QByteArrayLiteral("lp")};
+        for (const QString &argument : lpArguments) {
+            arguments << argument.toLocal8Bit();
+        }
+        std::vector<char *> argv;
+        for (QByteArray &argument : arguments) {
+            argv.push_back(argument.data());
+        }
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, pipeFds[0], STDIN_FILENO);
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init(&attributes);
+        posix_spawnattr_setsigmask(&attributes, &previousMask);
+        posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK);
+
+        pid_t pid = 0;
+        const int spawnError = posix_spawnp(&pid, "lp", &actions, &attributes, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attributes);
+        close(pipeFds[0]);
+
+        bool ok = false;
+        if (spawnError != 0) {
+            error = QStringLiteral("Cannot start lp: %1").arg(QString::fromLocal8Bit(strerror(spawnError)));
+            close(pipeFds[1]);
+        } else {
+            ok = transfer(documentFd, pipeFds[1], error);
+            close(pipeFds[1]);
+
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            // an early exit of lp explains an EPIPE better than the EPIPE itself
+            if (!(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+                error = QStringLiteral("lp failed with status %1").arg(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+                ok = false;
+            }
+        }
+
+        // drop a SIGPIPE raised while it was blocked before restoring the mask
+        const struct timespec noWait{0, 0};
+        while (sigtimedwait(&sigpipe, nullptr, &noWait) > 0) {
+        }
+        pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+        return ok;
+    }
+}
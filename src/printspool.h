@@ -0,0 +1,49 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+namespace LXQt
+{
+    // Moves a print job from the document fd handed over by the frontend to its
+    // destination without reading it into memory: copy_file_range() between files,
+    // splice() into the pipe of a spooler and sendfile() where neither applies. The
+    // document is always read from its start, independent of the fd's file offset.
+    class PrintSpool
+    {
+    public:
+        // writes the document to path, replacing an existing file
+        static bool toFile(int documentFd, const QString &path, QString &error);
+
+        // feeds the document to lp(1) on its standard input
+        static bool toPrinter(int documentFd, const QStringList &lpArguments, QString &error);
+
+        // copies everything from in, starting at offset 0, to out
+        static bool transfer(int in, int out, QString &error);
+    };
+}
@@ -0,0 +1,360 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#include "recentfiles.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QMimeDatabase>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtRecent, "xdp-lxqt-recent")
+
+    // "XRUI"
+    static constexpr quint32 IndexMagic = 0x58525549;
+    static constexpr quint32 IndexVersion = 1;
+    // a burst of inotify events, e.g. write and rename, is one refresh
+    static constexpr int RefreshDelay = 100;
+    // bounds the stat() calls of a query on a history full of deleted files
+    static constexpr int MaxChecksPerResult = 8;
+
+    // Hashes only need to be stable on this machine: different ones (other Qt, other CPU)
+    // make every element look changed and cost a full parse, never a wrong entry.
+    static quint64 hashBytes(const char *data, qint64 size)
+    {
+        return qHash(QByteArray::fromRawData(data, size), 0);
+    }
+
+    // Calls visit for every <bookmark> element starting at or after from and returns the end
+    // of the last complete one (from if there is none). The element passed to visit refers
+    // to data.
+    template<typename Visitor>
+    static qint64 forEachBookmark(const QByteArray &data, qint64 from, Visitor visit)
+    {
+        static const QByteArray open = QByteArrayLiteral("<bookmark ");
+        static const QByteArray close = QByteArrayLiteral("</bookmark>");
+        qint64 end = from;
+        qsizetype start = data.indexOf(open, from);
+        while (start >= 0) {
+            const qsizetype closing = data.indexOf(close, start + open.size());
+            if (closing < 0) {
+                break;
+            }
+            end = closing + close.size();
+            visit(QByteArray::fromRawData(data.constData() + start, end - start));
+            start = data.indexOf(open, end);
+        }
+        return end;
+    }
+
+    // GLib writes UTC times with a fraction of a second, the seconds are enough here
+    static qint64 parseTime(QStringView value)
+    {
+        if (value.size() < 19) {
+            return 0;
+        }
+        const QDateTime time = QDateTime::fromString(value.left(19).toString() + QLatin1Char('Z'), Qt::ISODate);
+        return time.isValid() ? time.toSecsSinceEpoch() : 0;
+    }
+
+    /*static*/ RecentFiles &RecentFiles::instance()
+    {
+        static RecentFiles files;
+        return files;
+    }
+
+    RecentFiles::RecentFiles()
+        : m_source{QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/recently-used.xbel")}
+        , m_cacheFile{QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/xdg-desktop-portal-lxqt/recently-used.index")}
+    {
+        m_refreshTimer.setSingleShot(true);
+        m_refreshTimer.setInterval(RefreshDelay);
+        connect(&m_refreshTimer, &QTimer::timeout, this, &RecentFiles::refresh);
+        // the file is replaced by a rename, which ends its own watch
+        connect(&m_watcher, &QFileSystemWatcher::fileChanged, &m_refreshTimer, [this] { m_refreshTimer.start(); });
+        connect(&m_watcher, &QFileSystemWatcher::directoryChanged, &m_refreshTimer, [this] { m_refreshTimer.start(); });
+
+        if (!load()) {
+            m_items.clear();
+            m_mimeTypes.clear();
+            m_mimeTypeIds.clear();
+        }
+        refresh();
+
+        const QString directory = QFileInfo{m_source}.absolutePath();
+        if (QFileInfo::exists(directory)) {
+            m_watcher.addPath(directory);
+        }
+    }
+
+    void RecentFiles::refresh()
+    {
+        if (QFileInfo::exists(m_source) && !m_watcher.files().contains(m_source)) {
+            m_watcher.addPath(m_source);
+        }
+
+        const QFileInfo info{m_source};
+        const qint64 size = info.exists() ? info.size() : -1;
+        const qint64 modified = info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+        if (size == m_sourceSize && modified == m_sourceModified) {
+            return;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QFile file{m_source};
+        uchar *map = nullptr;
+        if (size > 0) {
+            if (!file.open(QIODevice::ReadOnly) || (map = file.map(0, size)) == nullptr) {
+                qCWarning(XdgDesktopPortalLxqtRecent) << "Cannot read" << m_source << file.errorString();
+                return;
+            }
+        }
+        const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(map), map ? size : 0);
+
+        int parsed = 0;
+        bool appended = false;
+        if (m_indexedEnd > 0 && m_indexedEnd <= data.size() && hashBytes(data.constData(), m_indexedEnd) == m_indexedHash) {
+            // only new bookmarks behind the indexed part
+            appended = true;
+            m_indexedEnd = forEachBookmark(data, m_indexedEnd, [this, &parsed](const QByteArray &element) {
+                m_items << parseBookmark(element);
+                ++parsed;
+            });
+        } else {
+            QHash<quint64, int> previous;
+            previous.reserve(m_items.size());
+            for (int i = 0; i < m_items.size(); ++i) {
+                previous.insert(m_items.at(i).hash, i);
+            }
+            QList<Item> items;
+            items.reserve(m_items.size());
+            m_indexedEnd = forEachBookmark(data, 0, [this, &items, &previous, &parsed](const QByteArray &element) {
+                const auto known = previous.constFind(hashBytes(element.constData(), element.size()));
+                if (known != previous.cend()) {
+                    items << m_items.at(known.value());
+                } else {
+                    items << parseBookmark(element);
+                    ++parsed;
+                }
+            });
+            m_items = items;
+        }
+        m_indexedHash = hashBytes(data.constData(), m_indexedEnd);
+        m_sourceSize = size;
+        m_sourceModified = modified;
+        if (map) {
+            file.unmap(map);
+        }
+
+        sortByTime();
+        save();
+        qCDebug(XdgDesktopPortalLxqtRecent) << "Indexed" << m_items.size() << "recent files, parsed" << parsed
+                                            << (appended ? "appended" : "changed") << "bookmarks of" << size << "bytes in" << timer.elapsed() << "ms";
+        Q_EMIT changed();
+    }
+
+    RecentFiles::Item RecentFiles::parseBookmark(const QByteArray &element)
+    {
+        Item item{hashBytes(element.constData(), element.size()), {}, -1, 0};
+        // the bookmark:/mime: prefixes are declared on the root element, which isn't here
+        QXmlStreamReader reader{element};
+        reader.setNamespaceProcessing(false);
+        while (!reader.atEnd()) {
+            if (reader.readNext() != QXmlStreamReader::StartElement) {
+                continue;
+            }
+            const QStringView name = reader.qualifiedName();
+            if (name == QLatin1String("bookmark")) {
+                const QXmlStreamAttributes attributes = reader.attributes();
+                const QUrl url{attributes.value(QLatin1String("href")).toString()};
+                if (url.isLocalFile()) {
+                    item.path = url.toLocalFile().toUtf8();
+                }
+                for (const QLatin1String key : {QLatin1String("added"), QLatin1String("modified"), QLatin1String("visited")}) {
+                    item.time = qMax(item.time, parseTime(attributes.value(key)));
+                }
+            } else if (name == QLatin1String("mime:mime-type")) {
+                item.mimeType = mimeTypeId(reader.attributes().value(QLatin1String("type")).toString());
+            }
+        }
+        return item;
+    }
+
+    int RecentFiles::mimeTypeId(const QString &mimeType)
+    {
+        auto it = m_mimeTypeIds.constFind(mimeType);
+        if (it == m_mimeTypeIds.cend()) {
+            it = m_mimeTypeIds.insert(mimeType, m_mimeTypes.size());
+            m_mimeTypes << mimeType;
+        }
+        return it.value();
+    }
+
+    void RecentFiles::sortByTime()
+    {
+        m_byTime.resize(m_items.size());
+        // later in the file first among equal times
+        for (int i = 0; i < m_items.size(); ++i) {
+            m_byTime[i] = m_items.size() - 1 - i;
+        }
+        std::stable_sort(m_byTime.begin(), m_byTime.end(), [this](int a, int b) {
+            return m_items.at(a).time > m_items.at(b).time;
+        });
+    }
+
+    bool RecentFiles::load()
+    {
+        QFile file{m_cacheFile};
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        QDataStream in{&file};
+        in.setVersion(QDataStream::Qt_6_0);
+        quint32 magic = 0;
+        quint32 version = 0;
+        QString source;
+        in >> magic >> version >> source;
+        if (magic != IndexMagic || version != IndexVersion || source != m_source) {
+            return false;
+        }
+        quint32 count = 0;
+        in >> m_sourceSize >> m_sourceModified >> m_indexedEnd >> m_indexedHash >> m_mimeTypes >> count;
+        m_items.reserve(count);
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            Item item;
+            qint32 mimeType = -1;
+            in >> item.hash >> item.path >> mimeType >> item.time;
+            item.mimeType = mimeType < m_mimeTypes.size() ? mimeType : -1;
+            m_items << item;
+        }
+        if (in.status() != QDataStream::Ok) {
+            m_sourceSize = -1;
+            m_sourceModified = 0;
+            m_indexedEnd = 0;
+            return false;
+        }
+        for (int i = 0; i < m_mimeTypes.size(); ++i) {
+            m_mimeTypeIds.insert(m_mimeTypes.at(i), i);
+        }
+        sortByTime();
+        return true;
+    }
+
+    void RecentFiles::save() const
+    {
+        // the index lists the user's recent files, keep it as private as the history itself
+        const QString directory = QFileInfo{m_cacheFile}.absolutePath();
+        QDir{}.mkpath(directory);
+        QFile::setPermissions(directory, QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner);
+        QSaveFile file{m_cacheFile};
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+        file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+        QDataStream out{&file};
+        out.setVersion(QDataStream::Qt_6_0);
+        out << IndexMagic << IndexVersion << m_source
+            << m_sourceSize << m_sourceModified << m_indexedEnd << m_indexedHash << m_mimeTypes
+            << quint32(m_items.size());
+        for (const Item &item : m_items) {
+            out << item.hash << item.path << qint32(item.mimeType) << item.time;
+        }
+        if (!file.commit()) {
+            qCWarning(XdgDesktopPortalLxqtRecent) << "Cannot write" << m_cacheFile << file.errorString();
+        }
+    }
+
+    QList<RecentFiles::Entry> RecentFiles::query(const Filters &filters, int limit) const
+    {
+        QList<QRegularExpression> globs;
+        QStringList mimeTypes;
+        for (const Filter &filter : filters) {
+            if (filter.type == 0) {
+                globs << QRegularExpression{QRegularExpression::wildcardToRegularExpression(filter.filterString), QRegularExpression::CaseInsensitiveOption};
+            } else {
+                mimeTypes << filter.filterString;
+            }
+        }
+
+        // MIME filters are matched once per type in the index, not per file
+        QList<bool> typeMatches(m_mimeTypes.size(), false);
+        if (!mimeTypes.isEmpty()) {
+            const QMimeDatabase database;
+            for (int i = 0; i < m_mimeTypes.size(); ++i) {
+                const QMimeType type = database.mimeTypeForName(m_mimeTypes.at(i));
+                for (const QString &mimeType : mimeTypes) {
+                    if (m_mimeTypes.at(i) == mimeType || type.inherits(mimeType)) {
+                        typeMatches[i] = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        QList<Entry> entries;
+        int checks = 0;
+        for (int index : m_byTime) {
+            if (entries.size() >= limit || checks >= limit * MaxChecksPerResult) {
+                break;
+            }
+            const Item &item = m_items.at(index);
+            if (item.path.isEmpty()) {
+                continue;
+            }
+            bool matches = filters.isEmpty() || (item.mimeType >= 0 && typeMatches.at(item.mimeType));
+            if (!matches && !globs.isEmpty()) {
+                const QString name = QString::fromUtf8(item.path.mid(item.path.lastIndexOf('/') + 1));
+                matches = std::any_of(globs.cbegin(), globs.cend(), [&name](const QRegularExpression &glob) {
+                    return glob.match(name).hasMatch();
+                });
+            }
+            if (!matches) {
+                continue;
+            }
+            const QString path = QString::fromUtf8(item.path);
+            ++checks;
+            if (QFileInfo::exists(path)) {
+                entries << Entry{path, item.mimeType >= 0 ? m_mimeTypes.at(item.mimeType) : QString(), item.time};
+            }
+        }
+        return entries;
+    }
+}
@@ -0,0 +1,113 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#pragma once
+
+#include "filters.h"
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+namespace LXQt
+{
+    // Index of the local files in recently-used.xbel, for the Recent menu of the file dialog.
+    //
+    // The xbel file is not parsed as a whole. Its <bookmark> elements are located by a byte
+    // scan, and only elements whose bytes are new are parsed: when the file grew and the part
+    // indexed before is unchanged, only the appended region is looked at; otherwise every
+    // element is hashed and the entries of unchanged ones are kept. The index (paths, MIME
+    // type ids into a string table, times and element hashes) is saved to the cache
+    // directory, so a new process starts from it instead of the xbel file. Changes are
+    // picked up through inotify on the file and its directory, which GLib replaces it in.
+    class RecentFiles : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        struct Entry
+        {
+            QString path;
+            QString mimeType;
+            // last added, modified or visited, seconds since the epoch
+            qint64 time;
+        };
+
+        static RecentFiles &instance();
+
+        // Most recent first, at most limit existing files matching one of filters (globs on
+        // the name, MIME types including their subclasses); no filters match everything.
+        QList<Entry> query(const Filters &filters, int limit) const;
+
+    Q_SIGNALS:
+        void changed();
+
+    private:
+        RecentFiles();
+
+        struct Item
+        {
+            // hash of the <bookmark> element's bytes
+            quint64 hash;
+            // UTF-8, empty for bookmarks of non-local files
+            QByteArray path;
+            int mimeType;
+            qint64 time;
+        };
+
+        void refresh();
+        Item parseBookmark(const QByteArray &element);
+        int mimeTypeId(const QString &mimeType);
+        void sortByTime();
+        bool load();
+        void save() const;
+
+    private:
+        QString m_source;
+        QString m_cacheFile;
+
+        // state of the source the index was built from
+        qint64 m_sourceSize = -1;
+        qint64 m_sourceModified = 0;
+        // end of the last <bookmark> element and the hash of the bytes up to there
+        qint64 m_indexedEnd = 0;
+        quint64 m_indexedHash = 0;
+
+        QStringList m_mimeTypes;
+        QHash<QString, int> m_mimeTypeIds;
+        // in file order
+        QList<Item> m_items;
+        // indexes into m_items, most recent first
+        QList<int> m_byTime;
+
+        QFileSystemWatcher m_watcher;
+        QTimer m_refreshTimer;
+    };
+}
@@ -0,0 +1,122 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#include "recentplace.h"
+#include "filesearch.h"
+#include "recentfiles.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QIcon>
+#include <QLayout>
+#include <QMenu>
+#include <QMimeDatabase>
+#include <QToolButton>
+#include <QUrl>
+
+#include <libfm-qt6/filedialog.h>
+
+namespace LXQt
+{
+    // a menu, not a view: the most recent matches are what it is for
+    static constexpr int MaxEntries = 30;
+
+    /*static*/ void RecentPlace::attach(Fm::FileDialog &dialog, const QMap<QString, FilterList> &allFilters)
+    {
+        if (dialog.layout() == nullptr) {
+            return;
+        }
+        // loads or updates the index while the dialog is shown, not when the menu opens
+        RecentFiles::instance();
+        new RecentPlace{dialog, allFilters};
+    }
+
+    RecentPlace::RecentPlace(Fm::FileDialog &dialog, const QMap<QString, FilterList> &allFilters)
+        : QObject{&dialog}
+        , m_dialog{dialog}
+        , m_allFilters{allFilters}
+        , m_menu{new QMenu{&dialog}}
+    {
+        m_menu->setToolTipsVisible(true);
+        connect(m_menu, &QMenu::aboutToShow, this, &RecentPlace::fill);
+
+        auto button = new QToolButton;
+        button->setText(tr("Recent"));
+        button->setIcon(QIcon::fromTheme(QStringLiteral("document-open-recent")));
+        button->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
+        button->setPopupMode(QToolButton::InstantPopup);
+        button->setMenu(m_menu);
+        dialog.layout()->addWidget(button);
+    }
+
+    Filters RecentPlace::activeFilters() const
+    {
+        const QString nameFilter = m_dialog.selectedNameFilter();
+        // the request's own filters keep their MIME types, which the index matches directly
+        const auto it = m_allFilters.constFind(nameFilter);
+        if (it != m_allFilters.cend()) {
+            return it->filters;
+        }
+        Filters filters;
+        if (!nameFilter.isEmpty()) {
+            for (const QString &pattern : FileSearch::patternsFromNameFilter(nameFilter)) {
+                filters << Filter{0, pattern};
+            }
+        }
+        return filters;
+    }
+
+    void RecentPlace::fill()
+    {
+        m_menu->clear();
+        const QList<RecentFiles::Entry> entries = RecentFiles::instance().query(activeFilters(), MaxEntries);
+        if (entries.isEmpty()) {
+            m_menu->addAction(tr("No recent files"))->setEnabled(false);
+            return;
+        }
+
+        const QMimeDatabase database;
+        QHash<QString, QIcon> icons;
+        for (const RecentFiles::Entry &entry : entries) {
+            auto icon = icons.constFind(entry.mimeType);
+            if (icon == icons.cend()) {
+                const QMimeType type = database.mimeTypeForName(entry.mimeType);
+                icon = icons.insert(entry.mimeType, QIcon::fromTheme(type.iconName(), QIcon::fromTheme(type.genericIconName())));
+            }
+            auto action = m_menu->addAction(icon.value(), QFileInfo{entry.path}.fileName());
+            action->setToolTip(entry.path);
+            const QString path = entry.path;
+            connect(action, &QAction::triggered, this, [this, path] { open(path); });
+        }
+    }
+
+    void RecentPlace::open(const QString &path)
+    {
+        const QFileInfo info{path};
+        m_dialog.setDirectory(QUrl::fromLocalFile(info.absolutePath()));
+        m_dialog.selectFile(QUrl::fromLocalFile(info.absoluteFilePath()));
+    }
+}
@@ -0,0 +1,66 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#pragma once
+
+#include "filters.h"
+
+#include <QMap>
+#include <QObject>
+
+class QMenu;
+
+namespace Fm
+{
+    class FileDialog;
+}
+
+namespace LXQt
+{
+    // "Recent" button below an Open dialog's view. Its menu lists the recently used files
+    // matching the active name filter, taken from the RecentFiles index when the menu opens;
+    // picking one opens its folder in the dialog and selects it.
+    class RecentPlace : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // allFilters as filled by ExtractFilters(); does nothing if the dialog has no layout
+        static void attach(Fm::FileDialog &dialog, const QMap<QString, FilterList> &allFilters);
+
+    private:
+        RecentPlace(Fm::FileDialog &dialog, const QMap<QString, FilterList> &allFilters);
+
+        Filters activeFilters() const;
+        void fill();
+        void open(const QString &path);
+
+    private:
+        Fm::FileDialog &m_dialog;
+        QMap<QString, FilterList> m_allFilters;
+        QMenu *m_menu;
+    };
+}
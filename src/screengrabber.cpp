@@ -0,0 +1,165 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "screengrabber.h"
+
+#include <QGuiApplication>
+#include <QImageWriter>
+#include <QLoggingCategory>
+#include <QPixmap>
+#include <QSaveFile>
+#include <QScreen>
+
+#ifdef HAVE_XCB_SHM
+#include <xcb/shm.h>
+#include <xcb/xcb.h>
+
+#include <cstdlib>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtScreenGrabber, "xdp-lxqt-screen-grabber")
+
+#ifdef HAVE_XCB_SHM
+    struct SharedSegment {
+        xcb_connection_t *connection;
+        xcb_shm_seg_t segment;
+        void *address;
+    };
+
+    static void releaseSegment(void *info)
+    {
+        auto shared = static_cast<SharedSegment *>(info);
+        xcb_shm_detach(shared->connection, shared->segment);
+        xcb_flush(shared->connection);
+        shmdt(shared->address);
+        delete shared;
+    }
+
+    static QImage grabShared(const QRect &rect)
+    {
+        auto x11App = qGuiApp ? qGuiApp->nativeInterface<QNativeInterface::QX11Application>() : nullptr;
+        xcb_connection_t *connection = x11App ? x11App->connection() : nullptr;
+        if (connection == nullptr) {
+            return {};
+        }
+        const xcb_query_extension_reply_t *extension = xcb_get_extension_data(connection, &xcb_shm_id);
+        if (extension == nullptr || !extension->present) {
+            return {};
+        }
+        // ZPixmap of a 24/32 bit visual with LSB first byte order is BGRX, i.e. Format_RGB32
+        const xcb_setup_t *setup = xcb_get_setup(connection);
+        const xcb_screen_t *screen = xcb_setup_roots_iterator(setup).data;
+        if ((screen->root_depth != 24 && screen->root_depth != 32) || setup->image_byte_order != XCB_IMAGE_ORDER_LSB_FIRST
+                || QSysInfo::ByteOrder != QSysInfo::LittleEndian) {
+            return {};
+        }
+
+        const QRect area = rect.isNull() ? QRect(0, 0, screen->width_in_pixels, screen->height_in_pixels)
+                                         : rect.intersected(QRect(0, 0, screen->width_in_pixels, screen->height_in_pixels));
+        if (area.isEmpty()) {
+            return {};
+        }
+        const int bytesPerLine = area.width() * 4;
+        const int shmId = shmget(IPC_PRIVATE, static_cast<size_t>(bytesPerLine) * area.height(), IPC_CREAT | 0600);
+        if (shmId < 0) {
+            return {};
+        }
+        void *address = shmat(shmId, nullptr, 0);
+        if (address == reinterpret_cast<void *>(-1)) {
+            shmctl(shmId, IPC_RMID, nullptr);
+            return {};
+        }
+
+        const xcb_shm_seg_t segment = xcb_generate_id(connection);
+        xcb_generic_error_t *error = xcb_request_check(connection, xcb_shm_attach_checked(connection, segment, shmId, false));
+        // once both sides are attached the id is not needed; the memory goes away with the
+        // last detach, even if the portal crashes
+        shmctl(shmId, IPC_RMID, nullptr);
+        if (error != nullptr) {
+            // e.g. a remote X server, which can't see our memory
+            free(error);
+            shmdt(address);
+            return {};
+        }
+
+        xcb_shm_get_image_reply_t *reply = xcb_shm_get_image_reply(connection,
+                xcb_shm_get_image(connection, screen->root, area.x(), area.y(), area.width(), area.height(), ~0u, XCB_IMAGE_FORMAT_Z_PIXMAP, segment, 0),
+                &error);
+        if (reply == nullptr) {
+            free(error);
+            releaseSegment(new SharedSegment{connection, segment, address});
+            return {};
+        }
+        free(reply);
+
+        return QImage{static_cast<uchar *>(address), area.width(), area.height(), bytesPerLine, QImage::Format_RGB32,
+            releaseSegment, new SharedSegment{connection, segment, address}};
+    }
+#endif
+
+    /*static*/ QImage ScreenGrabber::grab(const QRect &rect)
+    {
+#ifdef HAVE_XCB_SHM
+        QImage image = grabShared(rect);
+        if (!image.isNull()) {
+            return image;
+        }
+        qCDebug(XdgDesktopPortalLxqtScreenGrabber) << "MIT-SHM capture not available, falling back to GetImage";
+#endif
+        QScreen *screen = QGuiApplication::primaryScreen();
+        if (screen == nullptr) {
+            return {};
+        }
+        // window 0 is the root window, which spans all monitors
+        const QPixmap pixmap = rect.isNull() ? screen->grabWindow(0) : screen->grabWindow(0, rect.x(), rect.y(), rect.width(), rect.height());
+        return pixmap.toImage();
+    }
+
+    /*static*/ bool ScreenGrabber::savePng(const QImage &image, const QString &fileName, QString &error)
+    {
+        QSaveFile file{fileName};
+        if (!file.open(QIODevice::WriteOnly)) {
+            error = file.errorString();
+            return false;
+        }
+        QImageWriter writer{&file, "png"};
+        // Qt maps quality 85 to zlib level 1: a few percent larger than the default level,
+        // several times faster on screen contents
+        writer.setQuality(85);
+        if (!writer.write(image)) {
+            error = writer.errorString();
+            return false;
+        }
+        if (!file.commit()) {
+            error = file.errorString();
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+namespace LXQt
+{
+    // Reads screen contents of the X11 root window. With MIT-SHM the server writes the
+    // pixels straight into a shared memory segment that becomes the QImage's buffer, so a
+    // 4K or multi-monitor capture costs no copy through the socket; the segment is released
+    // with the last copy of the image, which may be on another thread. Without the
+    // extension (remote displays, builds without xcb-shm) it falls back to QScreen::grabWindow().
+    class ScreenGrabber
+    {
+    public:
+        // rect is in root window pixels; a null rect grabs the whole root window, i.e.
+        // all monitors
+        static QImage grab(const QRect &rect = QRect());
+
+        // PNG with a fast zlib level, written row by row into fileName through a temporary file
+        static bool savePng(const QImage &image, const QString &fileName, QString &error);
+    };
+}
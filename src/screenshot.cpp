@@ -0,0 +1,220 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "screenshot.h"
+#include "colorpicker.h"
+#include "parentwindow.h"
+#include "screengrabber.h"
+#include "utils.h"
+
+#include <QCursor>
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDateTime>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QGuiApplication>
+#include <QLabel>
+#include <QLoggingCategory>
+#include <QRadioButton>
+#include <QScreen>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <QVBoxLayout>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtScreenshot, "xdp-lxqt-screenshot")
+
+    // the screen under the pointer in root window pixels
+    static QRect currentScreenRect()
+    {
+        QScreen *screen = QGuiApplication::screenAt(QCursor::pos());
+        if (screen == nullptr) {
+            screen = QGuiApplication::primaryScreen();
+        }
+        if (screen == nullptr) {
+            return {};
+        }
+        const QRect geometry = screen->geometry();
+        const qreal ratio = screen->devicePixelRatio();
+        return QRect{(geometry.topLeft() * ratio), geometry.size() * ratio};
+    }
+
+    static QRect virtualDesktopGeometry()
+    {
+        QScreen *screen = QGuiApplication::primaryScreen();
+        return screen ? screen->virtualGeometry() : QRect();
+    }
+
+    // waits in a nested loop, e.g. for a closed dialog to disappear from the screen
+    static void waitFor(int msec)
+    {
+        QEventLoop loop;
+        QTimer::singleShot(msec, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+
+    ScreenshotPortal::ScreenshotPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    uint ScreenshotPortal::Screenshot(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QVariantMap &options,
+            QVariantMap &results)
+    {
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "Screenshot called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    options: " << options;
+
+        ParentWindow::prefetch(parent_window);
+
+        bool modalDialog = true;
+        if (options.contains(QStringLiteral("modal"))) {
+            modalDialog = options.value(QStringLiteral("modal")).toBool();
+        }
+
+        // null means the whole root window
+        QRect area;
+        if (options.value(QStringLiteral("interactive")).toBool()) {
+            QDialog dialog;
+            dialog.setWindowTitle(tr("Take Screenshot"));
+            dialog.setWindowModality(modalDialog ? Qt::ApplicationModal : Qt::NonModal);
+            auto layout = new QVBoxLayout{&dialog};
+            auto wholeDesktop = new QRadioButton{tr("Entire desktop"), &dialog};
+            auto currentScreen = new QRadioButton{tr("Current screen"), &dialog};
+            wholeDesktop->setChecked(true);
+            layout->addWidget(wholeDesktop);
+            layout->addWidget(currentScreen);
+            auto buttonBox = new QDialogButtonBox{QDialogButtonBox::Cancel, &dialog};
+            buttonBox->addButton(tr("Take Screenshot"), QDialogButtonBox::AcceptRole);
+            QObject::connect(buttonBox, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+            QObject::connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+            layout->addWidget(buttonBox);
+            Utils::setParentWindow(&dialog, parent_window);
+
+            QEventLoop loop;
+            QObject::connect(&dialog, &QDialog::finished, &loop, &QEventLoop::quit);
+            dialog.open();
+            Utils::scheduleAutoResponse(&dialog);
+            loop.exec();
+            if (dialog.result() != QDialog::Accepted) {
+                return 1;
+            }
+            if (currentScreen->isChecked()) {
+                area = currentScreenRect();
+            }
+            // let the window manager unmap the dialog before it ends up in the picture
+            waitFor(200);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const QImage image = ScreenGrabber::grab(area);
+        const qint64 captureMs = timer.restart();
+        if (image.isNull()) {
+            qCWarning(XdgDesktopPortalLxqtScreenshot) << "Cannot capture the screen";
+            return 2;
+        }
+
+        QString directory = QStandardPaths::writableLocation(QStandardPaths::PicturesLocation);
+        if (directory.isEmpty() || !QDir().mkpath(directory)) {
+            directory = QDir::homePath();
+        }
+        const QString fileName = QDir{directory}.filePath(
+                QStringLiteral("Screenshot_%1.png").arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss_zzz"))));
+
+        // encoding a 4K capture takes far longer than grabbing it, keep the GUI thread free
+        bool saved = false;
+        QString error;
+        QThread *encoder = QThread::create([&] {
+            saved = ScreenGrabber::savePng(image, fileName, error);
+        });
+        QEventLoop loop;
+        QObject::connect(encoder, &QThread::finished, &loop, &QEventLoop::quit);
+        encoder->start();
+        loop.exec();
+        encoder->wait();
+        delete encoder;
+
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "Captured" << image.size() << "in" << captureMs << "ms, encoded in" << timer.elapsed() << "ms";
+
+        if (!saved) {
+            qCWarning(XdgDesktopPortalLxqtScreenshot) << "Cannot save" << fileName << ":" << error;
+            return 2;
+        }
+        results.insert(QStringLiteral("uri"), QUrl::fromLocalFile(fileName).toString());
+        return 0;
+    }
+
+    uint ScreenshotPortal::PickColor(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QVariantMap &options,
+            QVariantMap &results)
+    {
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "PickColor called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtScreenshot) << "    options: " << options;
+
+        const QImage capture = ScreenGrabber::grab();
+        if (capture.isNull()) {
+            qCWarning(XdgDesktopPortalLxqtScreenshot) << "Cannot capture the screen";
+            return 2;
+        }
+
+        // a frozen picture of the desktop, so the colors don't change under the pointer
+        ColorPicker picker{capture, virtualDesktopGeometry()};
+        QEventLoop loop;
+        QObject::connect(&picker, &QDialog::finished, &loop, &QEventLoop::quit);
+        picker.open();
+        Utils::scheduleAutoResponse(&picker);
+        loop.exec();
+
+        if (picker.result() != QDialog::Accepted || !picker.color().isValid()) {
+            return 1;
+        }
+
+        const QColor color = picker.color();
+        QDBusArgument argument;
+        argument.beginStructure();
+        argument << static_cast<double>(color.redF()) << static_cast<double>(color.greenF()) << static_cast<double>(color.blueF());
+        argument.endStructure();
+        results.insert(QStringLiteral("color"), QVariant::fromValue(argument));
+        return 0;
+    }
+}
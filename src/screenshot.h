@@ -0,0 +1,57 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+
+class QDBusObjectPath;
+
+namespace LXQt
+{
+    class ScreenshotPortal : public QDBusAbstractAdaptor
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.impl.portal.Screenshot")
+        Q_PROPERTY(uint version READ version CONSTANT)
+    public:
+        explicit ScreenshotPortal(QObject *parent);
+
+        uint version() const { return 2; }
+
+    public Q_SLOTS:
+        uint Screenshot(const QDBusObjectPath &handle,
+                const QString &app_id,
+                const QString &parent_window,
+                const QVariantMap &options,
+                QVariantMap &results);
+
+        uint PickColor(const QDBusObjectPath &handle,
+                const QString &app_id,
+                const QString &parent_window,
+                const QVariantMap &options,
+                QVariantMap &results);
+    };
+}
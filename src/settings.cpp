@@ -0,0 +1,181 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "settings.h"
+
+#include <QColor>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDir>
+#include <QFileInfo>
+#include <QLoggingCategory>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtSettings, "xdp-lxqt-settings")
+
+    // editors and lxqt-config write several times in a row
+    static constexpr int ReloadDelay = 100;
+
+    SettingsPortal::SettingsPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+        qDBusRegisterMetaType<VariantMapMap>();
+
+        m_reloadTimer.setSingleShot(true);
+        m_reloadTimer.setInterval(ReloadDelay);
+        connect(&m_reloadTimer, &QTimer::timeout, this, &SettingsPortal::reloadChanged);
+
+        // watched from the start, so SettingChanged is emitted even if nobody read yet;
+        // files are usually replaced rather than rewritten, which drops their watch, the
+        // directories tell about files that (re)appear
+        connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &file) {
+            m_changedFiles.insert(file);
+            m_reloadTimer.start();
+        });
+        connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &directory) {
+            for (const QString &file : m_snapshot.files()) {
+                if (QFileInfo{file}.absolutePath() == directory && !m_watcher.files().contains(file)) {
+                    m_changedFiles.insert(file);
+                }
+            }
+            if (!m_changedFiles.isEmpty()) {
+                m_reloadTimer.start();
+            }
+        });
+        watchFiles();
+    }
+
+    void SettingsPortal::ensureLoaded()
+    {
+        // parsing waits until somebody asks or a file changes
+        if (m_loaded) {
+            return;
+        }
+        m_loaded = true;
+        m_snapshot.reload();
+    }
+
+    void SettingsPortal::watchFiles()
+    {
+        const QStringList watchedFiles = m_watcher.files();
+        const QStringList watchedDirectories = m_watcher.directories();
+        for (const QString &file : m_snapshot.files()) {
+            const QFileInfo info{file};
+            if (info.exists() && !watchedFiles.contains(file)) {
+                m_watcher.addPath(file);
+            }
+            if (info.dir().exists() && !watchedDirectories.contains(info.absolutePath())) {
+                m_watcher.addPath(info.absolutePath());
+            }
+        }
+    }
+
+    void SettingsPortal::reloadChanged()
+    {
+        watchFiles();
+        const QSet<QString> files = m_changedFiles;
+        m_changedFiles.clear();
+        if (!m_loaded) {
+            // the values before the change were never parsed, so everything the changed
+            // files define now is announced
+            ensureLoaded();
+            QStringList changed;
+            for (const QString &file : files) {
+                changed << m_snapshot.namespacesOf(file);
+            }
+            changed.removeDuplicates();
+            // an empty pattern list would match everything
+            if (changed.isEmpty()) {
+                return;
+            }
+            const auto namespaces = m_snapshot.readAll(changed);
+            for (auto ns = namespaces.cbegin(); ns != namespaces.cend(); ++ns) {
+                for (auto value = ns->cbegin(); value != ns->cend(); ++value) {
+                    Q_EMIT SettingChanged(ns.key(), value.key(), QDBusVariant{toDBus(value.value())});
+                }
+            }
+            return;
+        }
+        for (const QString &file : files) {
+            const auto changes = m_snapshot.reload(file);
+            for (const auto &change : changes) {
+                qCDebug(XdgDesktopPortalLxqtSettings) << "Setting changed:" << change.nameSpace << change.key << change.value;
+                Q_EMIT SettingChanged(change.nameSpace, change.key, QDBusVariant{toDBus(change.value)});
+            }
+        }
+    }
+
+    /*static*/ QVariant SettingsPortal::toDBus(const QVariant &value)
+    {
+        if (value.typeId() == QMetaType::QColor) {
+            // accent-color is a (ddd) struct of sRGB components
+            const QColor color = value.value<QColor>();
+            QDBusArgument argument;
+            argument.beginStructure();
+            argument << color.redF() << color.greenF() << color.blueF();
+            argument.endStructure();
+            return QVariant::fromValue(argument);
+        }
+        return value;
+    }
+
+    VariantMapMap SettingsPortal::ReadAll(const QStringList &namespaces)
+    {
+        qCDebug(XdgDesktopPortalLxqtSettings) << "ReadAll called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtSettings) << "    namespaces: " << namespaces;
+
+        ensureLoaded();
+        VariantMapMap result = m_snapshot.readAll(namespaces);
+        // only the appearance namespace holds values that need converting; leave the
+        // others shared with the snapshot
+        auto appearance = result.find(QStringLiteral("org.freedesktop.appearance"));
+        if (appearance != result.end()) {
+            for (auto value = appearance->begin(); value != appearance->end(); ++value) {
+                value.value() = toDBus(value.value());
+            }
+        }
+        return result;
+    }
+
+    QDBusVariant SettingsPortal::Read(const QString &nameSpace, const QString &key, const QDBusMessage &message)
+    {
+        qCDebug(XdgDesktopPortalLxqtSettings) << "Read called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtSettings) << "    namespace: " << nameSpace;
+        qCDebug(XdgDesktopPortalLxqtSettings) << "    key: " << key;
+
+        ensureLoaded();
+        QVariant value;
+        if (!m_snapshot.read(nameSpace, key, value)) {
+            message.setDelayedReply(true);
+            QDBusConnection::sessionBus().send(message.createErrorReply(QStringLiteral("org.freedesktop.portal.Error.NotFound"),
+                QStringLiteral("Requested setting not found")));
+            return QDBusVariant{QVariant{0}};
+        }
+        return QDBusVariant{toDBus(value)};
+    }
+}
@@ -0,0 +1,72 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include "settingssnapshot.h"
+
+#include <QDBusAbstractAdaptor>
+#include <QDBusVariant>
+#include <QFileSystemWatcher>
+#include <QSet>
+#include <QTimer>
+
+class QDBusMessage;
+
+namespace LXQt
+{
+    using VariantMapMap = QMap<QString, QVariantMap>;
+
+    class SettingsPortal : public QDBusAbstractAdaptor
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.impl.portal.Settings")
+        Q_PROPERTY(uint version READ version CONSTANT)
+    public:
+        explicit SettingsPortal(QObject *parent);
+
+        uint version() const { return 1; }
+
+    public Q_SLOTS:
+        VariantMapMap ReadAll(const QStringList &namespaces);
+        QDBusVariant Read(const QString &nameSpace, const QString &key, const QDBusMessage &message);
+
+    Q_SIGNALS:
+        void SettingChanged(const QString &nameSpace, const QString &key, const QDBusVariant &value);
+
+    private:
+        void ensureLoaded();
+        void watchFiles();
+        void reloadChanged();
+        static QVariant toDBus(const QVariant &value);
+
+    private:
+        bool m_loaded = false;
+        SettingsSnapshot m_snapshot;
+        QFileSystemWatcher m_watcher;
+        QTimer m_reloadTimer;
+        QSet<QString> m_changedFiles;
+    };
+}
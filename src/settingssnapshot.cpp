@@ -0,0 +1,211 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "settingssnapshot.h"
+
+#include <QColor>
+#include <QFileInfo>
+#include <QSettings>
+#include <QStandardPaths>
+
+namespace LXQt
+{
+    static const QString AppearanceNamespace = QStringLiteral("org.freedesktop.appearance");
+    static const QString InterfaceNamespace = QStringLiteral("org.gnome.desktop.interface");
+    static const QString LxqtNamespacePrefix = QStringLiteral("org.lxqt.lxqt.");
+
+    SettingsSnapshot::SettingsSnapshot()
+    {
+        const QString name = QStringLiteral("/lxqt/lxqt.conf");
+        // standardLocations() lists the user's directory first
+        QStringList dataDirs = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
+        QStringList configDirs = QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation);
+        for (auto it = dataDirs.crbegin(); it != dataDirs.crend(); ++it) {
+            m_files << *it + name;
+        }
+        for (auto it = configDirs.crbegin(); it != configDirs.crend(); ++it) {
+            m_files << *it + name;
+        }
+        m_files.removeDuplicates();
+    }
+
+    /*static*/ SettingsSnapshot::Namespaces SettingsSnapshot::parse(const QString &file)
+    {
+        Namespaces namespaces;
+        if (!QFileInfo::exists(file)) {
+            return namespaces;
+        }
+        QSettings settings{file, QSettings::IniFormat};
+        for (const QString &group : settings.childGroups()) {
+            settings.beginGroup(group);
+            QVariantMap &values = namespaces[LxqtNamespacePrefix + group];
+            for (const QString &key : settings.childKeys()) {
+                QVariant value = settings.value(key);
+                // only types that map to D-Bus directly; "font=Sans,10" comes back as a list
+                if (value.typeId() != QMetaType::QString && value.typeId() != QMetaType::QStringList) {
+                    value = value.toString();
+                }
+                values.insert(key, value);
+            }
+            settings.endGroup();
+        }
+        return namespaces;
+    }
+
+    SettingsSnapshot::Namespaces SettingsSnapshot::merge() const
+    {
+        Namespaces merged;
+        for (const QString &file : m_files) {
+            const Namespaces &parsed = m_parsed.value(file);
+            for (auto ns = parsed.cbegin(); ns != parsed.cend(); ++ns) {
+                QVariantMap &values = merged[ns.key()];
+                for (auto value = ns->cbegin(); value != ns->cend(); ++value) {
+                    values.insert(value.key(), value.value());
+                }
+            }
+        }
+        deriveAppearance(merged);
+        deriveInterface(merged);
+        return merged;
+    }
+
+    /*static*/ void SettingsSnapshot::deriveAppearance(Namespaces &namespaces)
+    {
+        const QVariantMap palette = namespaces.value(LxqtNamespacePrefix + QStringLiteral("Palette"));
+        QVariantMap &appearance = namespaces[AppearanceNamespace];
+
+        // 0: no preference, 1: dark, 2: light
+        const QColor window = QColor::fromString(palette.value(QStringLiteral("window_color")).toString());
+        appearance.insert(QStringLiteral("color-scheme"), window.isValid() ? (window.lightness() < 128 ? 1u : 2u) : 0u);
+
+        const QColor highlight = QColor::fromString(palette.value(QStringLiteral("highlight_color")).toString());
+        if (highlight.isValid()) {
+            appearance.insert(QStringLiteral("accent-color"), highlight);
+        }
+    }
+
+    /*static*/ void SettingsSnapshot::deriveInterface(Namespaces &namespaces)
+    {
+        QVariantMap values;
+        const QString iconTheme = namespaces.value(LxqtNamespacePrefix + QStringLiteral("General")).value(QStringLiteral("icon_theme")).toString();
+        if (!iconTheme.isEmpty()) {
+            values.insert(QStringLiteral("icon-theme"), iconTheme);
+        }
+        // QFont::toString() ("Sans,10,-1,5,..."), split at the commas by QSettings unless
+        // it was quoted; the GNOME key holds a Pango description, "Sans 10"
+        const QVariant fontValue = namespaces.value(LxqtNamespacePrefix + QStringLiteral("Qt")).value(QStringLiteral("font"));
+        const QStringList font = fontValue.typeId() == QMetaType::QString
+            ? fontValue.toString().split(QLatin1Char(',')) : fontValue.toStringList();
+        if (font.size() >= 2 && !font.constFirst().isEmpty() && font.at(1).toDouble() > 0) {
+            values.insert(QStringLiteral("font-name"), QStringLiteral("%1 %2").arg(font.constFirst(), font.at(1)));
+        }
+        if (!values.isEmpty()) {
+            namespaces.insert(InterfaceNamespace, values);
+        }
+    }
+
+    QList<SettingsSnapshot::Change> SettingsSnapshot::reload(const QString &file)
+    {
+        if (file.isEmpty()) {
+            const QStringList &files = m_files;
+            for (const QString &path : files) {
+                m_parsed.insert(path, parse(path));
+            }
+        } else if (m_files.contains(file)) {
+            const Namespaces parsed = parse(file);
+            if (parsed == m_parsed.value(file)) {
+                return {};
+            }
+            m_parsed.insert(file, parsed);
+        } else {
+            return {};
+        }
+
+        const Namespaces merged = merge();
+        QList<Change> changes;
+        for (auto ns = merged.cbegin(); ns != merged.cend(); ++ns) {
+            const QVariantMap previous = m_merged.value(ns.key());
+            for (auto value = ns->cbegin(); value != ns->cend(); ++value) {
+                if (previous.value(value.key()) != value.value()) {
+                    changes.append(Change{ns.key(), value.key(), value.value()});
+                }
+            }
+        }
+        // keys that disappeared are not announced, Read() reports them as not found
+        m_merged = merged;
+        return changes;
+    }
+
+    /*static*/ bool SettingsSnapshot::matches(const QString &pattern, const QString &nameSpace)
+    {
+        if (pattern.isEmpty()) {
+            return true;
+        }
+        if (pattern.endsWith(QLatin1Char('*'))) {
+            return nameSpace.startsWith(QStringView{pattern}.chopped(1));
+        }
+        return nameSpace == pattern;
+    }
+
+    SettingsSnapshot::Namespaces SettingsSnapshot::readAll(const QStringList &patterns) const
+    {
+        if (patterns.isEmpty()) {
+            return m_merged;
+        }
+        // a handful of namespaces, the values themselves are shared, not copied
+        Namespaces result;
+        for (auto ns = m_merged.cbegin(); ns != m_merged.cend(); ++ns) {
+            for (const QString &pattern : patterns) {
+                if (matches(pattern, ns.key())) {
+                    result.insert(ns.key(), ns.value());
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    QStringList SettingsSnapshot::namespacesOf(const QString &file) const
+    {
+        QStringList namespaces = m_parsed.value(file).keys();
+        const QStringList derived = {AppearanceNamespace, InterfaceNamespace};
+        for (const QString &nameSpace : derived) {
+            if (!namespaces.isEmpty() && m_merged.contains(nameSpace)) {
+                namespaces << nameSpace;
+            }
+        }
+        return namespaces;
+    }
+
+    bool SettingsSnapshot::read(const QString &nameSpace, const QString &key, QVariant &value) const
+    {
+        const auto ns = m_merged.constFind(nameSpace);
+        if (ns == m_merged.cend() || !ns->contains(key)) {
+            return false;
+        }
+        value = ns->value(key);
+        return true;
+    }
+}
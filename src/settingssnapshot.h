@@ -0,0 +1,85 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QStringList>
+#include <QVariant>
+
+namespace LXQt
+{
+    // Parsed copy of the LXQt settings served by the Settings portal. Every group of
+    // lxqt.conf becomes a namespace "org.lxqt.lxqt.<group>". The standard keys are derived
+    // from it: org.freedesktop.appearance from the palette (color-scheme, accent-color as a
+    // QColor; contrast is left out, LXQt has no such setting), and the icon theme and the
+    // Qt font as icon-theme and font-name of org.gnome.desktop.interface, the namespace
+    // GTK and other toolkits read them from.
+    // lxqt.conf is layered like LXQt reads it: the defaults in the data dirs, then the XDG
+    // config dirs, the user's file last. Each file is parsed separately, so a change only
+    // re-parses the file that changed; reload() returns the keys whose merged value changed.
+    class SettingsSnapshot
+    {
+    public:
+        using Namespaces = QMap<QString, QVariantMap>;
+
+        struct Change
+        {
+            QString nameSpace;
+            QString key;
+            QVariant value;
+        };
+
+        SettingsSnapshot();
+
+        // every location lxqt.conf may appear at, lowest priority first; may not exist
+        const QStringList &files() const { return m_files; }
+
+        // re-parses file (all files if empty) and reports the changed keys
+        QList<Change> reload(const QString &file = QString());
+
+        // the namespaces matching one of patterns ("ns", "prefix*", or "" for all)
+        Namespaces readAll(const QStringList &patterns) const;
+        bool read(const QString &nameSpace, const QString &key, QVariant &value) const;
+
+        // the namespaces with values from file, including the ones derived from it
+        QStringList namespacesOf(const QString &file) const;
+
+        static bool matches(const QString &pattern, const QString &nameSpace);
+
+    private:
+        static Namespaces parse(const QString &file);
+        Namespaces merge() const;
+        static void deriveAppearance(Namespaces &namespaces);
+        static void deriveInterface(Namespaces &namespaces);
+
+    private:
+        QStringList m_files;
+        QHash<QString, Namespaces> m_parsed;
+        Namespaces m_merged;
+    };
+}
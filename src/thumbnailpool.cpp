@@ -0,0 +1,55 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#include "thumbnailpool.h"
+#include "portalsettings.h"
+
+#include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
+
+#include <libfm-qt6/core/thumbnailjob.h>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtThumbnails, "xdp-lxqt-thumbnails")
+
+    void configureThumbnailPool()
+    {
+        int threads = PortalSettings::instance().thumbnailThreads();
+        if (threads == 0) {
+            threads = qBound(1, QThread::idealThreadCount() / 2, 2);
+        }
+        QThreadPool *pool = Fm::ThumbnailJob::threadPool();
+        pool->setMaxThreadCount(threads);
+        // decoding must not compete with the dialog's own threads
+        pool->setThreadPriority(QThread::LowPriority);
+
+        Fm::ThumbnailJob::setLocalFilesOnly(true);
+        Fm::ThumbnailJob::setMaxThumbnailFileSize(MaxThumbnailFileSizeKiB);
+        qCDebug(XdgDesktopPortalLxqtThumbnails) << "Thumbnails on" << threads << "low-priority threads, local files up to" << MaxThumbnailFileSizeKiB << "KiB";
+    }
+}
@@ -0,0 +1,40 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#pragma once
+
+namespace LXQt
+{
+    // sources above this size get no thumbnail
+    static constexpr int MaxThumbnailFileSizeKiB = 64 * 1024;
+
+    // Configures libfm-qt's thumbnail pool for the whole process. libfm-qt generates
+    // thumbnails only for the items a view paints, and all its ThumbnailJobs share one
+    // pool; it gets a small number of low-priority threads (ThumbnailThreads in the
+    // settings, 2 at most by default), and the jobs are limited to local files of a bounded
+    // size. Jobs of rows scrolled out of view are not cancelled, libfm-qt has no API for it.
+    void configureThumbnailPool();
+}
@@ -0,0 +1,56 @@
+#!/bin/sh
+# Runs the same OpenFile/SaveFile load against the portal with in-process dialogs and with
+# dialog workers (DialogWorkers=true) and prints both reports: the load generator's latency
+# and portal RSS, and for workers the averages of what each one logs (time to serve the
+# request, start-up time, peak RSS).
+#
+# usage: compare-dialog-workers.sh [portal binary] [loadgen binary] [requests] [dialog ms]
+# Needs dbus-run-session, and Xvfb unless DISPLAY is set.
+
+set -e
+
+PORTAL=${1:-/usr/libexec/xdg-desktop-portal-lxqt}
+LOADGEN=${2:-xdg-desktop-portal-lxqt-loadgen}
+REQUESTS=${3:-200}
+DIALOG_MS=${4:-200}
+
+WORK=$(mktemp -d)
+trap 'kill $XVFB 2>/dev/null; rm -rf "$WORK"' EXIT
+
+if [ -z "$DISPLAY" ]; then
+    Xvfb :98 -screen 0 1920x1080x24 >/dev/null 2>&1 &
+    XVFB=$!
+    export DISPLAY=:98
+    sleep 1
+fi
+
+for workers in false true; do
+    mkdir -p "$WORK/$workers/lxqt"
+    printf '[FileDialog]\nDialogWorkers=%s\n' "$workers" > "$WORK/$workers/lxqt/xdg-desktop-portal-lxqt.conf"
+
+    echo "== DialogWorkers=$workers"
+    XDG_CONFIG_HOME="$WORK/$workers" \
+    XDG_DESKTOP_PORTAL_LXQT_AUTO_RESPONSE="reject:$DIALOG_MS" \
+    QT_LOGGING_RULES="xdp-lxqt-dialog-worker.debug=true" \
+        dbus-run-session -- sh -c "'$PORTAL' 2>'$WORK/$workers.log' & sleep 2; \
+            '$LOADGEN' --requests $REQUESTS --concurrency 1 --mix open=1,save=1 --rss-interval 1000"
+
+    if [ "$workers" = true ]; then
+        awk '/served by worker/ {
+                gsub(/"/, "")
+                for (i = 1; i <= NF; ++i) {
+                    if ($i == "in" && $(i + 1) ~ /^[0-9]+$/ && !served) { served = $(i + 1) }
+                    if ($i == "initialised") { init += $(i + 2) }
+                    if ($i == "RSS") { rss += $(i + 1) }
+                }
+                total += served; served = 0; ++n
+            }
+            END {
+                if (n > 0) {
+                    printf "workers: %d, mean serve %.1f ms, mean start-up %.1f ms, mean peak RSS %.0f kB\n", n, total / n, init / n, rss / n
+                } else {
+                    print "workers: none logged"
+                }
+            }' "$WORK/$workers.log"
+    fi
+done
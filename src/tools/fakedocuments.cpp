@@ -0,0 +1,130 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMetaType>
+#include <QFile>
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QTextStream>
+
+#include <unistd.h>
+
+// Stand-in for xdg-document-portal on a private session bus, for testing how the backend
+// resolves document paths without a FUSE mount. Each "<id>=<host path>" argument exports
+// one document; GetMountPoint reports --mount-point, which doesn't need to exist.
+
+namespace LXQt
+{
+    class FakeDocuments : public QObject, protected QDBusContext
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.portal.Documents")
+
+    public:
+        FakeDocuments(const QByteArray &mountPoint, const QMap<QString, QByteArray> &documents, bool legacy)
+            : m_mountPoint{mountPoint}
+            , m_documents{documents}
+            , m_legacy{legacy}
+        {
+        }
+
+    public Q_SLOTS:
+        QByteArray GetMountPoint()
+        {
+            return m_mountPoint + '\0';
+        }
+
+        QMap<QString, QByteArray> GetHostPaths(const QStringList &ids)
+        {
+            QMap<QString, QByteArray> paths;
+            if (m_legacy) {
+                // a version 4 document portal, callers have to fall back to Info
+                sendErrorReply(QDBusError::UnknownMethod, QStringLiteral("No such method GetHostPaths"));
+                return paths;
+            }
+            for (const QString &id : ids) {
+                if (m_documents.contains(id)) {
+                    paths.insert(id, m_documents.value(id) + '\0');
+                }
+            }
+            return paths;
+        }
+
+        QByteArray Info(const QString &id, QMap<QString, QStringList> &apps)
+        {
+            apps.clear();
+            return m_documents.value(id) + '\0';
+        }
+
+    private:
+        QByteArray m_mountPoint;
+        QMap<QString, QByteArray> m_documents;
+        bool m_legacy;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt-fakedocuments"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Serves org.freedesktop.portal.Documents with a fixed set of documents"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("documents"), QStringLiteral("Exported documents as <id>=<host path>."), QStringLiteral("[<id>=<host path>...]"));
+    const QCommandLineOption mountPointOption{QStringLiteral("mount-point"), QStringLiteral("Reported document mount point."), QStringLiteral("path"), QStringLiteral("/run/user/%1/doc").arg(getuid())};
+    const QCommandLineOption legacyOption{QStringLiteral("legacy"), QStringLiteral("Behave like a document portal without GetHostPaths.")};
+    parser.addOptions({mountPointOption, legacyOption});
+    parser.process(app);
+
+    QMap<QString, QByteArray> documents;
+    for (const QString &argument : parser.positionalArguments()) {
+        const int separator = argument.indexOf(QLatin1Char('='));
+        if (separator <= 0) {
+            parser.showHelp(1);
+        }
+        documents.insert(argument.left(separator), QFile::encodeName(argument.mid(separator + 1)));
+    }
+
+    qDBusRegisterMetaType<QMap<QString, QByteArray>>();
+    qDBusRegisterMetaType<QMap<QString, QStringList>>();
+
+    LXQt::FakeDocuments service{QFile::encodeName(parser.value(mountPointOption)), documents, parser.isSet(legacyOption)};
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.registerObject(QStringLiteral("/org/freedesktop/portal/documents"), &service, QDBusConnection::ExportAllSlots)
+            || !bus.registerService(QStringLiteral("org.freedesktop.portal.Documents"))) {
+        QTextStream(stderr) << "Cannot register the document portal: " << bus.lastError().message() << Qt::endl;
+        return 1;
+    }
+
+    return app.exec();
+}
+
+#include "fakedocuments.moc"
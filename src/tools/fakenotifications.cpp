@@ -0,0 +1,159 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+#include <QVariantMap>
+
+// Stand-in for a notification daemon on a private session bus. It serves
+// org.freedesktop.Notifications, shows nothing and, after each burst, prints how many
+// calls reached it and how fast; together with the loadgen "notify" mix this measures
+// what the portal's coalescing and batching leave of a burst.
+
+namespace LXQt
+{
+    class FakeNotifications : public QObject
+    {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Notifications")
+
+    public:
+        explicit FakeNotifications(int idleMs)
+        {
+            m_idleTimer.setSingleShot(true);
+            m_idleTimer.setInterval(idleMs);
+            connect(&m_idleTimer, &QTimer::timeout, this, &FakeNotifications::report);
+        }
+
+    public Q_SLOTS:
+        uint Notify(const QString &app_name, uint replaces_id, const QString &app_icon, const QString &summary,
+                const QString &body, const QStringList &actions, const QVariantMap &hints, int expire_timeout)
+        {
+            Q_UNUSED(app_name)
+            Q_UNUSED(app_icon)
+            Q_UNUSED(summary)
+            Q_UNUSED(body)
+            Q_UNUSED(actions)
+            Q_UNUSED(expire_timeout)
+
+            touch();
+            ++m_notify;
+            if (hints.contains(QStringLiteral("image-data"))) {
+                ++m_images;
+            }
+            if (replaces_id != 0 && replaces_id <= m_lastId) {
+                ++m_replaced;
+                return replaces_id;
+            }
+            return ++m_lastId;
+        }
+
+        void CloseNotification(uint id)
+        {
+            Q_UNUSED(id)
+            touch();
+            ++m_closed;
+        }
+
+        QStringList GetCapabilities()
+        {
+            return {QStringLiteral("actions"), QStringLiteral("body"), QStringLiteral("body-markup"), QStringLiteral("persistence")};
+        }
+
+        QString GetServerInformation(QString &vendor, QString &version, QString &spec_version)
+        {
+            vendor = QStringLiteral("LXQt");
+            version = QStringLiteral("0");
+            spec_version = QStringLiteral("1.2");
+            return QStringLiteral("xdg-desktop-portal-lxqt-fakenotifications");
+        }
+
+    Q_SIGNALS:
+        void NotificationClosed(uint id, uint reason);
+        void ActionInvoked(uint id, const QString &action_key);
+
+    private:
+        void touch()
+        {
+            if (!m_burst.isValid()) {
+                m_burst.start();
+            }
+            m_lastCallMs = m_burst.elapsed();
+            m_idleTimer.start();
+        }
+
+        void report()
+        {
+            const qint64 elapsedMs = qMax<qint64>(1, m_lastCallMs);
+            QTextStream(stdout) << "burst: " << m_notify << " Notify (" << m_replaced << " replacing, "
+                                << m_images << " with image data) " << m_closed << " CloseNotification"
+                                << " in " << m_lastCallMs << "ms, "
+                                << QString::number((m_notify + m_closed) * 1000.0 / elapsedMs, 'f', 1) << " calls/s" << Qt::endl;
+            m_burst.invalidate();
+            m_notify = m_replaced = m_images = m_closed = 0;
+        }
+
+    private:
+        QTimer m_idleTimer;
+        QElapsedTimer m_burst;
+        qint64 m_lastCallMs = 0;
+        uint m_lastId = 0;
+        int m_notify = 0;
+        int m_replaced = 0;
+        int m_images = 0;
+        int m_closed = 0;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt-fakenotifications"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Serves org.freedesktop.Notifications and reports the calls of each burst"));
+    parser.addHelpOption();
+    const QCommandLineOption idleOption{QStringLiteral("idle"), QStringLiteral("Quiet time in ms that ends a burst."), QStringLiteral("ms"), QStringLiteral("1000")};
+    parser.addOption(idleOption);
+    parser.process(app);
+
+    LXQt::FakeNotifications service{qMax(10, parser.value(idleOption).toInt())};
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.registerObject(QStringLiteral("/org/freedesktop/Notifications"), &service, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals)
+            || !bus.registerService(QStringLiteral("org.freedesktop.Notifications"))) {
+        QTextStream(stderr) << "Cannot register the notification service: " << bus.lastError().message() << Qt::endl;
+        return 1;
+    }
+
+    return app.exec();
+}
+
+#include "fakenotifications.moc"
@@ -0,0 +1,422 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "choices.h"
+#include "filters.h"
+#include "stats.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include <algorithm>
+#include <iterator>
+
+// Drives org.freedesktop.impl.portal.FileChooser, .Access, .Notification and .Screenshot of a running portal
+// (usually on a private session bus, started with XDG_DESKTOP_PORTAL_LXQT_AUTO_RESPONSE set)
+// with a configurable mix of concurrent requests and reports throughput, latency
+// percentiles and the portal's RSS over time.
+
+namespace LXQt
+{
+    class LoadGenerator : public QObject
+    {
+        Q_OBJECT
+    public:
+        enum Method {
+            OpenFile,
+            SaveFile,
+            Access,
+            Notify,
+            Screenshot,
+            MethodCount
+        };
+
+        struct Config {
+            int requests = 100;
+            int concurrency = 4;
+            int filters = 10;
+            int patternsPerFilter = 5;
+            int choices = 4;
+            int choiceValues = 5;
+            int notificationIds = 50;
+            bool multiple = true;
+            int timeoutMs = 60000;
+            int rssIntervalMs = 500;
+            QString currentFolder;
+            QString parentWindow;
+            int weights[MethodCount] = {1, 1, 1, 0, 0};
+        };
+
+        LoadGenerator(const QDBusConnection &connection, const Config &config, QObject *parent = nullptr);
+
+        void start();
+
+    Q_SIGNALS:
+        void finished();
+
+    private:
+        Method nextMethod();
+        QDBusMessage buildRequest(Method method, int serial) const;
+        QVariantMap fileChooserOptions(Method method) const;
+        void issue();
+        void onReplied(QDBusPendingCallWatcher *watcher, Method method, qint64 startNs);
+        void report();
+
+        static const char *methodName(Method method);
+
+        QDBusConnection m_connection;
+        Config m_config;
+        QRandomGenerator m_random{42};
+        QElapsedTimer m_clock;
+        RssSampler *m_rss = nullptr;
+        int m_issued = 0;
+        int m_completed = 0;
+        int m_errors = 0;
+        LatencyStats m_total;
+        LatencyStats m_perMethod[MethodCount];
+        QMap<uint, int> m_responses;
+    };
+
+    LoadGenerator::LoadGenerator(const QDBusConnection &connection, const Config &config, QObject *parent)
+        : QObject(parent)
+        , m_connection{connection}
+        , m_config{config}
+    {
+    }
+
+    const char *LoadGenerator::methodName(Method method)
+    {
+        switch (method) {
+        case OpenFile:
+            return "OpenFile";
+        case SaveFile:
+            return "SaveFile";
+        case Access:
+            return "AccessDialog";
+        case Notify:
+            return "AddNotification";
+        case Screenshot:
+            return "Screenshot";
+        default:
+            return "";
+        }
+    }
+
+    void LoadGenerator::start()
+    {
+        registerFilterMetaTypes();
+        registerChoiceMetaTypes();
+
+        m_rss = new RssSampler{portalPid(m_connection), m_config.rssIntervalMs, this};
+        m_rss->start();
+        m_clock.start();
+
+        const int initial = qMin(m_config.concurrency, m_config.requests);
+        for (int i = 0; i < initial; ++i) {
+            issue();
+        }
+        if (initial == 0) {
+            report();
+        }
+    }
+
+    LoadGenerator::Method LoadGenerator::nextMethod()
+    {
+        int sum = 0;
+        for (int weight : m_config.weights) {
+            sum += weight;
+        }
+        int pick = static_cast<int>(m_random.bounded(sum));
+        for (int i = 0; i < MethodCount; ++i) {
+            if (pick < m_config.weights[i]) {
+                return static_cast<Method>(i);
+            }
+            pick -= m_config.weights[i];
+        }
+        return OpenFile;
+    }
+
+    QVariantMap LoadGenerator::fileChooserOptions(Method method) const
+    {
+        QVariantMap options;
+        options.insert(QStringLiteral("modal"), false);
+        options.insert(QStringLiteral("accept_label"), QStringLiteral("_Accept"));
+
+        if (method == OpenFile) {
+            options.insert(QStringLiteral("multiple"), m_config.multiple);
+        } else {
+            options.insert(QStringLiteral("current_name"), QStringLiteral("loadgen-output.txt"));
+        }
+
+        if (!m_config.currentFolder.isEmpty()) {
+            // the portal frontend sends NUL terminated byte strings
+            QByteArray folder = m_config.currentFolder.toLocal8Bit();
+            folder.append('\0');
+            options.insert(QStringLiteral("current_folder"), folder);
+        }
+
+        if (m_config.filters > 0) {
+            FilterListList filterListList;
+            filterListList.reserve(m_config.filters);
+            for (int i = 0; i < m_config.filters; ++i) {
+                FilterList filterList;
+                filterList.userVisibleName = QStringLiteral("Filter %1").arg(i);
+                for (int j = 0; j < m_config.patternsPerFilter; ++j) {
+                    filterList.filters.append({0, QStringLiteral("*.ext%1x%2").arg(i).arg(j)});
+                }
+                // mix in MIME type filters, they are the expensive ones on the portal side
+                if (i % 2 == 1) {
+                    filterList.filters.append({1, QStringLiteral("image/png")});
+                }
+                filterListList.append(filterList);
+            }
+            options.insert(QStringLiteral("current_filter"), QVariant::fromValue(filterListList.constFirst()));
+            options.insert(QStringLiteral("filters"), QVariant::fromValue(filterListList));
+        }
+
+        return options;
+    }
+
+    QDBusMessage LoadGenerator::buildRequest(Method method, int serial) const
+    {
+        const QString service = QStringLiteral("org.freedesktop.impl.portal.desktop.lxqt");
+        const QString path = QStringLiteral("/org/freedesktop/portal/desktop");
+        const QDBusObjectPath handle{QStringLiteral("/org/freedesktop/portal/desktop/request/loadgen/r%1").arg(serial)};
+        const QString appId = QStringLiteral("org.lxqt.LoadGenerator");
+        const QString title = QStringLiteral("Load generator request %1").arg(serial);
+
+        if (method == Notify) {
+            // a small set of ids, so bursts contain updates the portal can coalesce
+            QVariantMap notification;
+            notification.insert(QStringLiteral("title"), title);
+            notification.insert(QStringLiteral("body"), QStringLiteral("Body text of notification %1").arg(serial));
+            notification.insert(QStringLiteral("priority"), QStringLiteral("normal"));
+
+            QDBusMessage message = QDBusMessage::createMethodCall(service, path, QStringLiteral("org.freedesktop.impl.portal.Notification"), QStringLiteral("AddNotification"));
+            message << appId << QStringLiteral("n%1").arg(serial % qMax(1, m_config.notificationIds)) << notification;
+            return message;
+        }
+
+        if (method == Screenshot) {
+            // non-interactive, so the latency is capture plus encoding of the whole root window
+            QVariantMap options;
+            options.insert(QStringLiteral("modal"), false);
+            options.insert(QStringLiteral("interactive"), false);
+
+            QDBusMessage message = QDBusMessage::createMethodCall(service, path, QStringLiteral("org.freedesktop.impl.portal.Screenshot"), QStringLiteral("Screenshot"));
+            message << QVariant::fromValue(handle) << appId << m_config.parentWindow << options;
+            return message;
+        }
+
+        if (method == Access) {
+            QVariantMap options;
+            options.insert(QStringLiteral("modal"), false);
+            options.insert(QStringLiteral("grant_label"), QStringLiteral("_Allow"));
+            options.insert(QStringLiteral("deny_label"), QStringLiteral("_Deny"));
+            if (m_config.choices > 0) {
+                OptionList optionList;
+                optionList.reserve(m_config.choices);
+                for (int i = 0; i < m_config.choices; ++i) {
+                    Option option;
+                    option.id = QStringLiteral("option%1").arg(i);
+                    option.label = QStringLiteral("Option %1").arg(i);
+                    // every other option is a boolean (empty list of choices)
+                    if (i % 2 == 0) {
+                        for (int j = 0; j < m_config.choiceValues; ++j) {
+                            option.choices.append({QStringLiteral("value%1").arg(j), QStringLiteral("Value %1").arg(j)});
+                        }
+                        option.initialChoiceId = QStringLiteral("value0");
+                    } else {
+                        option.initialChoiceId = QStringLiteral("true");
+                    }
+                    optionList.append(option);
+                }
+                options.insert(QStringLiteral("choices"), QVariant::fromValue(optionList));
+            }
+
+            QDBusMessage message = QDBusMessage::createMethodCall(service, path, QStringLiteral("org.freedesktop.impl.portal.Access"), QStringLiteral("AccessDialog"));
+            message << QVariant::fromValue(handle) << appId << m_config.parentWindow << title
+                    << QStringLiteral("Subtitle") << QStringLiteral("Body text of the access request") << options;
+            return message;
+        }
+
+        QDBusMessage message = QDBusMessage::createMethodCall(service, path, QStringLiteral("org.freedesktop.impl.portal.FileChooser"), QString::fromLatin1(methodName(method)));
+        message << QVariant::fromValue(handle) << appId << m_config.parentWindow << title << fileChooserOptions(method);
+        return message;
+    }
+
+    void LoadGenerator::issue()
+    {
+        const Method method = nextMethod();
+        const QDBusMessage message = buildRequest(method, m_issued++);
+        const qint64 startNs = m_clock.nsecsElapsed();
+        auto watcher = new QDBusPendingCallWatcher{m_connection.asyncCall(message, m_config.timeoutMs), this};
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, method, startNs](QDBusPendingCallWatcher *w) {
+            onReplied(w, method, startNs);
+        });
+    }
+
+    void LoadGenerator::onReplied(QDBusPendingCallWatcher *watcher, Method method, qint64 startNs)
+    {
+        const qint64 latency = m_clock.nsecsElapsed() - startNs;
+        watcher->deleteLater();
+
+        ++m_completed;
+        if (watcher->isError()) {
+            ++m_errors;
+            QTextStream(stderr) << methodName(method) << " failed: " << watcher->error().message() << Qt::endl;
+        } else {
+            // AddNotification has no response code
+            if (method != Notify) {
+                const QDBusPendingReply<uint, QVariantMap> reply = *watcher;
+                ++m_responses[reply.argumentAt<0>()];
+            }
+            m_total.add(latency);
+            m_perMethod[method].add(latency);
+        }
+
+        if (m_issued < m_config.requests) {
+            issue();
+        } else if (m_completed == m_config.requests) {
+            report();
+        }
+    }
+
+    void LoadGenerator::report()
+    {
+        const qint64 elapsedMs = m_clock.elapsed();
+        m_rss->stop();
+
+        QTextStream out{stdout};
+        out << "requests: " << m_completed << " (errors: " << m_errors << ")"
+            << " concurrency: " << m_config.concurrency
+            << " elapsed: " << elapsedMs << "ms"
+            << " throughput: " << QString::number(elapsedMs > 0 ? m_completed * 1000.0 / elapsedMs : 0.0, 'f', 1) << " req/s"
+            << Qt::endl;
+        for (auto it = m_responses.cbegin(); it != m_responses.cend(); ++it) {
+            out << "response " << it.key() << ": " << it.value() << Qt::endl;
+        }
+        m_total.report(out, QStringLiteral("all"));
+        for (int i = 0; i < MethodCount; ++i) {
+            if (m_perMethod[i].count() > 0) {
+                m_perMethod[i].report(out, QString::fromLatin1(methodName(static_cast<Method>(i))));
+            }
+        }
+        m_rss->report(out);
+
+        Q_EMIT finished();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt-loadgen"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Load generator for the LXQt portal backend"));
+    parser.addHelpOption();
+    const QCommandLineOption addressOption{QStringLiteral("address"), QStringLiteral("D-Bus address of the (private) session bus the portal runs on."), QStringLiteral("address")};
+    const QCommandLineOption requestsOption{QStringLiteral("requests"), QStringLiteral("Total number of requests."), QStringLiteral("n"), QStringLiteral("100")};
+    const QCommandLineOption concurrencyOption{QStringLiteral("concurrency"), QStringLiteral("Number of requests in flight."), QStringLiteral("n"), QStringLiteral("4")};
+    const QCommandLineOption mixOption{QStringLiteral("mix"), QStringLiteral("Request mix as weights, e.g. open=5,save=3,access=2,notify=1,screenshot=1."), QStringLiteral("mix"), QStringLiteral("open=1,save=1,access=1")};
+    const QCommandLineOption filtersOption{QStringLiteral("filters"), QStringLiteral("Number of filter lists per FileChooser request."), QStringLiteral("n"), QStringLiteral("10")};
+    const QCommandLineOption patternsOption{QStringLiteral("patterns"), QStringLiteral("Number of glob patterns per filter list."), QStringLiteral("n"), QStringLiteral("5")};
+    const QCommandLineOption choicesOption{QStringLiteral("choices"), QStringLiteral("Number of choices per AccessDialog request."), QStringLiteral("n"), QStringLiteral("4")};
+    const QCommandLineOption choiceValuesOption{QStringLiteral("choice-values"), QStringLiteral("Number of values of each non-boolean choice."), QStringLiteral("n"), QStringLiteral("5")};
+    const QCommandLineOption notificationIdsOption{QStringLiteral("notification-ids"), QStringLiteral("Number of distinct notification ids AddNotification cycles through."), QStringLiteral("n"), QStringLiteral("50")};
+    const QCommandLineOption singleOption{QStringLiteral("single"), QStringLiteral("Do not request multiple selection in OpenFile.")};
+    const QCommandLineOption folderOption{QStringLiteral("current-folder"), QStringLiteral("Folder passed as current_folder."), QStringLiteral("path")};
+    const QCommandLineOption parentOption{QStringLiteral("parent-window"), QStringLiteral("Handle passed as parent_window, e.g. x11:<hex window id>."), QStringLiteral("handle")};
+    const QCommandLineOption timeoutOption{QStringLiteral("timeout"), QStringLiteral("Per-request D-Bus timeout in ms."), QStringLiteral("ms"), QStringLiteral("60000")};
+    const QCommandLineOption rssOption{QStringLiteral("rss-interval"), QStringLiteral("Interval of portal RSS samples in ms."), QStringLiteral("ms"), QStringLiteral("500")};
+    parser.addOptions({addressOption, requestsOption, concurrencyOption, mixOption, filtersOption, patternsOption,
+                       choicesOption, choiceValuesOption, notificationIdsOption, singleOption, folderOption, parentOption, timeoutOption, rssOption});
+    parser.process(app);
+
+    LXQt::LoadGenerator::Config config;
+    config.requests = parser.value(requestsOption).toInt();
+    config.concurrency = qMax(1, parser.value(concurrencyOption).toInt());
+    config.filters = parser.value(filtersOption).toInt();
+    config.patternsPerFilter = qMax(1, parser.value(patternsOption).toInt());
+    config.choices = parser.value(choicesOption).toInt();
+    config.choiceValues = qMax(1, parser.value(choiceValuesOption).toInt());
+    config.notificationIds = qMax(1, parser.value(notificationIdsOption).toInt());
+    config.multiple = !parser.isSet(singleOption);
+    config.currentFolder = parser.value(folderOption);
+    config.parentWindow = parser.value(parentOption);
+    config.timeoutMs = parser.value(timeoutOption).toInt();
+    config.rssIntervalMs = qMax(10, parser.value(rssOption).toInt());
+
+    const QStringList mix = parser.value(mixOption).split(QLatin1Char(','), Qt::SkipEmptyParts);
+    std::fill(std::begin(config.weights), std::end(config.weights), 0);
+    for (const QString &entry : mix) {
+        const QString name = entry.section(QLatin1Char('='), 0, 0).trimmed();
+        const int weight = qMax(0, entry.section(QLatin1Char('='), 1, 1).toInt());
+        if (name == QLatin1String("open")) {
+            config.weights[LXQt::LoadGenerator::OpenFile] = weight;
+        } else if (name == QLatin1String("save")) {
+            config.weights[LXQt::LoadGenerator::SaveFile] = weight;
+        } else if (name == QLatin1String("access")) {
+            config.weights[LXQt::LoadGenerator::Access] = weight;
+        } else if (name == QLatin1String("notify")) {
+            config.weights[LXQt::LoadGenerator::Notify] = weight;
+        } else if (name == QLatin1String("screenshot")) {
+            config.weights[LXQt::LoadGenerator::Screenshot] = weight;
+        } else {
+            QTextStream(stderr) << "Unknown request type in --mix: " << name << Qt::endl;
+            return 1;
+        }
+    }
+    if (std::all_of(std::begin(config.weights), std::end(config.weights), [](int w) { return w == 0; })) {
+        QTextStream(stderr) << "--mix selects no requests" << Qt::endl;
+        return 1;
+    }
+
+    QDBusConnection connection = parser.isSet(addressOption)
+        ? QDBusConnection::connectToBus(parser.value(addressOption), QStringLiteral("loadgen"))
+        : QDBusConnection::sessionBus();
+    if (!connection.isConnected()) {
+        QTextStream(stderr) << "Cannot connect to D-Bus: " << connection.lastError().message() << Qt::endl;
+        return 1;
+    }
+
+    LXQt::LoadGenerator generator{connection, config};
+    QObject::connect(&generator, &LXQt::LoadGenerator::finished, &app, &QCoreApplication::quit);
+    generator.start();
+
+    return app.exec();
+}
+
+#include "loadgen.moc"
@@ -0,0 +1,164 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+
+#include "stats.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusUnixFileDescriptor>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QUrl>
+#include <QVariantMap>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Prints a document to a file through the Print portal of a running portal (started with
+// XDG_DESKTOP_PORTAL_LXQT_AUTO_RESPONSE=accept) and checks the result: PreparePrint is
+// answered with an output-uri destination, Print hands over the document fd with the
+// returned token, and the output must be byte-identical to the document. The portal's RSS
+// is sampled meanwhile, so printing a large PDF shows whether the portal streams it.
+
+namespace
+{
+    const QString Service = QStringLiteral("org.freedesktop.impl.portal.desktop.lxqt");
+    const QString Path = QStringLiteral("/org/freedesktop/portal/desktop");
+    const QString Interface = QStringLiteral("org.freedesktop.impl.portal.Print");
+    const QString AppId = QStringLiteral("org.lxqt.PrintCheck");
+
+    bool sameContents(const QString &first, const QString &second)
+    {
+        QFile a{first};
+        QFile b{second};
+        if (!a.open(QIODevice::ReadOnly) || !b.open(QIODevice::ReadOnly) || a.size() != b.size()) {
+            return false;
+        }
+        // in chunks, the documents are meant to be large
+        while (!a.atEnd()) {
+            if (a.read(1 << 20) != b.read(1 << 20)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt-printcheck"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Prints a document to a file through the portal and compares the output"));
+    parser.addHelpOption();
+    const QCommandLineOption addressOption{QStringLiteral("address"), QStringLiteral("D-Bus address of the (private) session bus the portal runs on."), QStringLiteral("address")};
+    const QCommandLineOption outputOption{QStringLiteral("output"), QStringLiteral("File the portal prints to."), QStringLiteral("path"),
+        QDir::tempPath() + QStringLiteral("/xdg-desktop-portal-lxqt-printcheck.pdf")};
+    const QCommandLineOption runsOption{QStringLiteral("runs"), QStringLiteral("Number of PreparePrint/Print rounds."), QStringLiteral("n"), QStringLiteral("1")};
+    const QCommandLineOption rssOption{QStringLiteral("rss-interval"), QStringLiteral("Interval of portal RSS samples in ms."), QStringLiteral("ms"), QStringLiteral("100")};
+    parser.addOptions({addressOption, outputOption, runsOption, rssOption});
+    parser.addPositionalArgument(QStringLiteral("document"), QStringLiteral("Document to print, e.g. a large PDF."));
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+    const QString document = parser.positionalArguments().constFirst();
+    const QString output = QFileInfo{parser.value(outputOption)}.absoluteFilePath();
+    const int runs = qMax(1, parser.value(runsOption).toInt());
+
+    QDBusConnection connection = parser.isSet(addressOption)
+        ? QDBusConnection::connectToBus(parser.value(addressOption), QStringLiteral("printcheck"))
+        : QDBusConnection::sessionBus();
+    if (!connection.isConnected()) {
+        QTextStream(stderr) << "Cannot connect to D-Bus: " << connection.lastError().message() << Qt::endl;
+        return 1;
+    }
+
+    QTextStream out{stdout};
+    LXQt::RssSampler rss{LXQt::portalPid(connection), qMax(10, parser.value(rssOption).toInt())};
+    rss.start();
+
+    int failures = 0;
+    for (int run = 0; run < runs; ++run) {
+        QFile::remove(output);
+
+        // the settings a user would pick in the dialog; GtkPrintSettings keys
+        QVariantMap settings;
+        settings.insert(QStringLiteral("output-uri"), QUrl::fromLocalFile(output).toString());
+        settings.insert(QStringLiteral("output-file-format"), QStringLiteral("pdf"));
+        QDBusMessage prepare = QDBusMessage::createMethodCall(Service, Path, Interface, QStringLiteral("PreparePrint"));
+        prepare << QVariant::fromValue(QDBusObjectPath{QStringLiteral("/org/freedesktop/portal/desktop/request/printcheck/p%1").arg(run)})
+                << AppId << QString{} << QStringLiteral("Print check") << settings << QVariantMap{} << QVariantMap{};
+        // BlockWithGui keeps the RSS sampler running
+        const QDBusMessage prepared = connection.call(prepare, QDBus::BlockWithGui, 10 * 60 * 1000);
+        if (prepared.type() != QDBusMessage::ReplyMessage || prepared.arguments().size() != 2 || prepared.arguments().at(0).toUInt() != 0) {
+            out << "run " << run << ": PreparePrint failed: " << (prepared.type() == QDBusMessage::ErrorMessage ? prepared.errorMessage() : QStringLiteral("not accepted")) << Qt::endl;
+            ++failures;
+            continue;
+        }
+        const QVariantMap results = qdbus_cast<QVariantMap>(prepared.arguments().at(1));
+        const uint token = results.value(QStringLiteral("token")).toUInt();
+
+        const int fd = open(QFile::encodeName(document).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            QTextStream(stderr) << "Cannot open " << document << Qt::endl;
+            return 1;
+        }
+        QDBusMessage print = QDBusMessage::createMethodCall(Service, Path, Interface, QStringLiteral("Print"));
+        print << QVariant::fromValue(QDBusObjectPath{QStringLiteral("/org/freedesktop/portal/desktop/request/printcheck/r%1").arg(run)})
+              << AppId << QString{} << QStringLiteral("Print check") << QVariant::fromValue(QDBusUnixFileDescriptor{fd})
+              << QVariantMap{{QStringLiteral("token"), token}};
+        // QDBusUnixFileDescriptor holds a duplicate
+        close(fd);
+
+        QElapsedTimer timer;
+        timer.start();
+        const QDBusMessage printed = connection.call(print, QDBus::BlockWithGui, 10 * 60 * 1000);
+        const qint64 elapsedMs = timer.elapsed();
+        const bool replied = printed.type() == QDBusMessage::ReplyMessage && !printed.arguments().isEmpty() && printed.arguments().at(0).toUInt() == 0;
+        const bool identical = replied && sameContents(document, output);
+        const qint64 size = QFileInfo{document}.size();
+        out << "run " << run << ": " << (identical ? "ok" : replied ? "output differs" : "Print failed")
+            << " " << size / 1024 << "KiB in " << elapsedMs << "ms"
+            << " (" << QString::number(elapsedMs > 0 ? size / 1048.576 / elapsedMs : 0.0, 'f', 1) << " MiB/s)" << Qt::endl;
+        if (!identical) {
+            ++failures;
+        }
+    }
+
+    rss.stop();
+    rss.report(out);
+    QFile::remove(output);
+    return failures == 0 ? 0 : 1;
+}
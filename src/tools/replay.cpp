@@ -0,0 +1,253 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "choices.h"
+#include "filters.h"
+#include "portaltrace.h"
+#include "stats.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QTextStream>
+#include <QTimer>
+
+// Sends a trace recorded with XDG_DESKTOP_PORTAL_LXQT_TRACE back to a portal instance,
+// at the original pace or accelerated, and reports latency and the portal's RSS.
+
+namespace LXQt
+{
+    class Replayer : public QObject
+    {
+        Q_OBJECT
+    public:
+        Replayer(const QDBusConnection &connection, const QString &fileName, double speed, int maxInFlight, QObject *parent = nullptr);
+
+        bool start(QString &error);
+
+    Q_SIGNALS:
+        void finished();
+
+    private:
+        void scheduleNext();
+        void send();
+        void onReplied(QDBusPendingCallWatcher *watcher, const QString &method, qint64 startNs);
+        void maybeFinish();
+        QDBusMessage buildRequest(const TraceRecord &record);
+
+        QDBusConnection m_connection;
+        TraceReader m_reader;
+        double m_speed;
+        int m_maxInFlight;
+        TraceRecord m_pending;
+        bool m_hasPending = false;
+        bool m_waitingForSlot = false;
+        bool m_readerDone = false;
+        QTimer m_timer;
+        QElapsedTimer m_clock;
+        RssSampler *m_rss = nullptr;
+        int m_sent = 0;
+        int m_inFlight = 0;
+        int m_errors = 0;
+        int m_skippedOptions = 0;
+        qint64 m_maxLagMs = 0;
+        LatencyStats m_total;
+        QMap<QString, LatencyStats> m_perMethod;
+    };
+
+    Replayer::Replayer(const QDBusConnection &connection, const QString &fileName, double speed, int maxInFlight, QObject *parent)
+        : QObject(parent)
+        , m_connection{connection}
+        , m_reader{fileName}
+        , m_speed{speed}
+        , m_maxInFlight{maxInFlight}
+    {
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, [this] {
+            if (m_inFlight >= m_maxInFlight) {
+                m_waitingForSlot = true;
+                return;
+            }
+            send();
+            scheduleNext();
+        });
+    }
+
+    bool Replayer::start(QString &error)
+    {
+        if (!m_reader.isValid()) {
+            error = m_reader.errorString();
+            return false;
+        }
+        registerFilterMetaTypes();
+        registerChoiceMetaTypes();
+        m_rss = new RssSampler{portalPid(m_connection), 1000, this};
+        m_rss->start();
+        m_clock.start();
+        scheduleNext();
+        return true;
+    }
+
+    void Replayer::scheduleNext()
+    {
+        m_hasPending = m_reader.next(m_pending);
+        if (!m_hasPending) {
+            if (!m_reader.errorString().isEmpty()) {
+                QTextStream(stderr) << "Stopped reading trace: " << m_reader.errorString() << Qt::endl;
+            }
+            m_readerDone = true;
+            maybeFinish();
+            return;
+        }
+        const qint64 due = m_speed > 0 ? static_cast<qint64>(m_pending.msecs / m_speed) : 0;
+        m_timer.start(qMax<qint64>(0, due - m_clock.elapsed()));
+    }
+
+    QDBusMessage Replayer::buildRequest(const TraceRecord &record)
+    {
+        const QVariantMap options = record.dbusOptions(&m_skippedOptions);
+
+        const bool access = record.method == QLatin1String("AccessDialog");
+        const QString interface = access ? QStringLiteral("org.freedesktop.impl.portal.Access") : QStringLiteral("org.freedesktop.impl.portal.FileChooser");
+        QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.impl.portal.desktop.lxqt"),
+                QStringLiteral("/org/freedesktop/portal/desktop"), interface, record.method);
+        message << QVariant::fromValue(QDBusObjectPath{QStringLiteral("/org/freedesktop/portal/desktop/request/replay/r%1").arg(m_sent)});
+        const int stringArguments = access ? 5 : 3;
+        for (int i = 0; i < stringArguments; ++i) {
+            message << record.arguments.value(i);
+        }
+        message << options;
+        return message;
+    }
+
+    void Replayer::send()
+    {
+        const qint64 due = m_speed > 0 ? static_cast<qint64>(m_pending.msecs / m_speed) : 0;
+        m_maxLagMs = qMax(m_maxLagMs, m_clock.elapsed() - due);
+
+        const QString method = m_pending.method;
+        const QDBusMessage message = buildRequest(m_pending);
+        ++m_sent;
+        ++m_inFlight;
+        const qint64 startNs = m_clock.nsecsElapsed();
+        auto watcher = new QDBusPendingCallWatcher{m_connection.asyncCall(message, 10 * 60 * 1000), this};
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, method, startNs](QDBusPendingCallWatcher *w) {
+            onReplied(w, method, startNs);
+        });
+    }
+
+    void Replayer::onReplied(QDBusPendingCallWatcher *watcher, const QString &method, qint64 startNs)
+    {
+        const qint64 latency = m_clock.nsecsElapsed() - startNs;
+        const QDBusPendingReply<uint, QVariantMap> reply = *watcher;
+        watcher->deleteLater();
+        --m_inFlight;
+
+        if (reply.isError()) {
+            ++m_errors;
+            QTextStream(stderr) << method << " failed: " << reply.error().message() << Qt::endl;
+        } else {
+            m_total.add(latency);
+            m_perMethod[method].add(latency);
+        }
+
+        if (m_waitingForSlot) {
+            m_waitingForSlot = false;
+            send();
+            scheduleNext();
+        }
+        maybeFinish();
+    }
+
+    void Replayer::maybeFinish()
+    {
+        if (!m_readerDone || m_inFlight > 0) {
+            return;
+        }
+        m_rss->stop();
+
+        QTextStream out{stdout};
+        out << "replayed: " << m_sent << " (errors: " << m_errors << ")"
+            << " elapsed: " << m_clock.elapsed() << "ms"
+            << " max send lag: " << m_maxLagMs << "ms" << Qt::endl;
+        if (m_skippedOptions > 0) {
+            out << "options with unsupported signatures skipped: " << m_skippedOptions << Qt::endl;
+        }
+        m_total.report(out, QStringLiteral("all"));
+        for (auto it = m_perMethod.cbegin(); it != m_perMethod.cend(); ++it) {
+            it.value().report(out, it.key());
+        }
+        m_rss->report(out);
+
+        Q_EMIT finished();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+    app.setApplicationName(QStringLiteral("xdg-desktop-portal-lxqt-replay"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays a recorded portal trace against the LXQt portal backend"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("trace"), QStringLiteral("Trace file recorded with XDG_DESKTOP_PORTAL_LXQT_TRACE."));
+    const QCommandLineOption addressOption{QStringLiteral("address"), QStringLiteral("D-Bus address of the (private) session bus the portal runs on."), QStringLiteral("address")};
+    const QCommandLineOption speedOption{QStringLiteral("speed"), QStringLiteral("Pace factor, 1 is the original pace, 0 sends as fast as possible."), QStringLiteral("factor"), QStringLiteral("1")};
+    const QCommandLineOption inFlightOption{QStringLiteral("max-in-flight"), QStringLiteral("Maximum number of requests in flight."), QStringLiteral("n"), QStringLiteral("64")};
+    parser.addOptions({addressOption, speedOption, inFlightOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    QDBusConnection connection = parser.isSet(addressOption)
+        ? QDBusConnection::connectToBus(parser.value(addressOption), QStringLiteral("replay"))
+        : QDBusConnection::sessionBus();
+    if (!connection.isConnected()) {
+        QTextStream(stderr) << "Cannot connect to D-Bus: " << connection.lastError().message() << Qt::endl;
+        return 1;
+    }
+
+    LXQt::Replayer replayer{connection, parser.positionalArguments().constFirst(),
+        qMax(0.0, parser.value(speedOption).toDouble()), qMax(1, parser.value(inFlightOption).toInt())};
+    QObject::connect(&replayer, &LXQt::Replayer::finished, &app, &QCoreApplication::quit);
+    QString error;
+    if (!replayer.start(error)) {
+        QTextStream(stderr) << "Cannot replay trace: " << error << Qt::endl;
+        return 1;
+    }
+
+    return app.exec();
+}
+
+#include "replay.moc"
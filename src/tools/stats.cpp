@@ -0,0 +1,153 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "stats.h"
+
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusReply>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace LXQt
+{
+    void LatencyStats::add(qint64 nsecs)
+    {
+        m_samples.push_back(nsecs);
+        m_sorted = false;
+    }
+
+    double LatencyStats::percentileMs(double p) const
+    {
+        if (m_samples.empty()) {
+            return 0.0;
+        }
+        if (!m_sorted) {
+            std::sort(m_samples.begin(), m_samples.end());
+            m_sorted = true;
+        }
+        // nearest-rank method
+        const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * m_samples.size()));
+        const size_t index = std::min(m_samples.size() - 1, rank > 0 ? rank - 1 : 0);
+        return m_samples[index] / 1e6;
+    }
+
+    double LatencyStats::meanMs() const
+    {
+        if (m_samples.empty()) {
+            return 0.0;
+        }
+        const double sum = std::accumulate(m_samples.cbegin(), m_samples.cend(), 0.0);
+        return sum / m_samples.size() / 1e6;
+    }
+
+    void LatencyStats::report(QTextStream &out, const QString &label) const
+    {
+        out << qSetFieldWidth(12) << Qt::left << label << qSetFieldWidth(0)
+            << " n=" << count()
+            << " mean=" << QString::number(meanMs(), 'f', 2) << "ms"
+            << " p50=" << QString::number(percentileMs(50), 'f', 2) << "ms"
+            << " p95=" << QString::number(percentileMs(95), 'f', 2) << "ms"
+            << " p99=" << QString::number(percentileMs(99), 'f', 2) << "ms"
+            << Qt::endl;
+    }
+
+    RssSampler::RssSampler(qint64 pid, int intervalMs, QObject *parent)
+        : QObject(parent)
+        , m_pid{pid}
+    {
+        m_timer.setInterval(intervalMs);
+        connect(&m_timer, &QTimer::timeout, this, &RssSampler::sample);
+    }
+
+    void RssSampler::start()
+    {
+        if (m_pid <= 0) {
+            return;
+        }
+        m_clock.start();
+        sample();
+        m_timer.start();
+    }
+
+    void RssSampler::stop()
+    {
+        if (m_timer.isActive()) {
+            m_timer.stop();
+            sample();
+        }
+    }
+
+    void RssSampler::sample()
+    {
+        const qint64 rss = readRssKiB(m_pid);
+        if (rss >= 0) {
+            m_samples.append(qMakePair(m_clock.elapsed(), rss));
+        }
+    }
+
+    void RssSampler::report(QTextStream &out) const
+    {
+        if (m_samples.isEmpty()) {
+            out << "portal RSS: not available" << Qt::endl;
+            return;
+        }
+        qint64 peak = 0;
+        for (const auto &sample : m_samples) {
+            peak = std::max(peak, sample.second);
+        }
+        out << "portal RSS (pid " << m_pid << "): start=" << m_samples.first().second << "KiB"
+            << " end=" << m_samples.last().second << "KiB"
+            << " peak=" << peak << "KiB" << Qt::endl;
+        for (const auto &sample : m_samples) {
+            out << "  t=" << sample.first << "ms rss=" << sample.second << "KiB" << Qt::endl;
+        }
+    }
+
+    qint64 RssSampler::readRssKiB(qint64 pid)
+    {
+        QFile status{QStringLiteral("/proc/%1/status").arg(pid)};
+        if (!status.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("VmRSS:")) {
+                return line.mid(6).trimmed().split(' ').value(0).toLongLong();
+            }
+        }
+        return -1;
+    }
+
+    qint64 portalPid(const QDBusConnection &connection)
+    {
+        const QDBusReply<uint> reply = connection.interface()->servicePid(QStringLiteral("org.freedesktop.impl.portal.desktop.lxqt"));
+        return reply.isValid() ? static_cast<qint64>(reply.value()) : -1;
+    }
+}
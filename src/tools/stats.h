@@ -0,0 +1,83 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QTimer>
+
+#include <vector>
+
+class QDBusConnection;
+class QTextStream;
+
+namespace LXQt
+{
+    // Collects per-request latencies and reports nearest-rank percentiles.
+    class LatencyStats
+    {
+    public:
+        void add(qint64 nsecs);
+        int count() const { return static_cast<int>(m_samples.size()); }
+        // p in [0, 100]
+        double percentileMs(double p) const;
+        double meanMs() const;
+        void report(QTextStream &out, const QString &label) const;
+
+    private:
+        mutable std::vector<qint64> m_samples;
+        mutable bool m_sorted = true;
+    };
+
+    // Periodically samples the resident set size of a process from /proc.
+    class RssSampler : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit RssSampler(qint64 pid, int intervalMs, QObject *parent = nullptr);
+
+        void start();
+        void stop();
+        void report(QTextStream &out) const;
+
+        static qint64 readRssKiB(qint64 pid);
+
+    private:
+        void sample();
+
+        qint64 m_pid;
+        QTimer m_timer;
+        QElapsedTimer m_clock;
+        // (msecs since start, RSS in KiB)
+        QList<QPair<qint64, qint64>> m_samples;
+    };
+
+    // Returns the pid of the process owning the portal's well-known name, or -1.
+    qint64 portalPid(const QDBusConnection &connection);
+}
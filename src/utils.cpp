@@ -28,24 +28,11 @@
 
 #include "utils.h"
 
-#include <KWindowSystem>
-
+#include <QDialog>
 #include <QString>
-#include <QWidget>
+#include <QTimer>
 
-void Utils::setParentWindow(QWidget *w, const QString &parent_window)
-{
-    if (parent_window.startsWith(QLatin1String("x11:"))) {
-        w->setAttribute(Qt::WA_NativeWindow, true);
-        KWindowSystem::setMainWindow(w->windowHandle(), parent_window.mid(4).toULongLong(nullptr, 16));
-    }
-    if (parent_window.startsWith((QLatin1String("wayland:")))) {
-        if (!w->window()->windowHandle()) {
-            w->window()->winId(); // create QWindow
-        }
-        KWindowSystem::setMainWindow(w->window()->windowHandle(), parent_window.mid(strlen("wayland:")));
-    }
-}
+// Utils::setParentWindow() is defined in parentwindow.cpp, which is part of the daemon.
 
 void Utils::convertGtkMnemonic(QString &label)
 {
@@ -57,3 +44,27 @@ void Utils::convertGtkMnemonic(QString &label)
         label.replace(mnemonicPos, 1, QChar::fromLatin1('&'));
     }
 }
+
+void Utils::scheduleAutoResponse(QDialog *dialog)
+{
+    static const QString spec = qEnvironmentVariable("XDG_DESKTOP_PORTAL_LXQT_AUTO_RESPONSE");
+    if (spec.isEmpty()) {
+        return;
+    }
+
+    const QString action = spec.section(QLatin1Char(':'), 0, 0);
+    const int delay = spec.section(QLatin1Char(':'), 1, 1).toInt();
+    if (action == QLatin1String("accept")) {
+        QTimer::singleShot(delay, dialog, [dialog] {
+            // give the dialog a chance to validate its selection first
+            dialog->accept();
+            if (dialog->isVisible()) {
+                dialog->done(QDialog::Accepted);
+            }
+        });
+    } else if (action == QLatin1String("reject")) {
+        QTimer::singleShot(delay, dialog, [dialog] {
+            dialog->reject();
+        });
+    }
+}
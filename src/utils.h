@@ -28,13 +28,20 @@
 
 #pragma once
 
+class QDialog;
 class QString;
 class QWidget;
 
 class Utils
 {
 public:
+    // Call LXQt::ParentWindow::prefetch() as early as possible and this right before the
+    // dialog is shown. Part of the daemon, not of the core library.
     static void setParentWindow(QWidget *w, const QString &parent_window);
     static void convertGtkMnemonic(QString &label);
+    // Non-interactive mode for load testing: when XDG_DESKTOP_PORTAL_LXQT_AUTO_RESPONSE
+    // is set to "accept" or "reject" (optionally followed by ":<msec>"), the dialog
+    // is closed automatically with that result.
+    static void scheduleAutoResponse(QDialog *dialog);
 };
 
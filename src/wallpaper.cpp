@@ -0,0 +1,192 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "wallpaper.h"
+#include "parentwindow.h"
+#include "portalsettings.h"
+#include "utils.h"
+#include "wallpaperimage.h"
+
+#include <QDBusObjectPath>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QEventLoop>
+#include <QGuiApplication>
+#include <QLabel>
+#include <QLoggingCategory>
+#include <QProcess>
+#include <QPushButton>
+#include <QScreen>
+#include <QStandardPaths>
+#include <QThread>
+#include <QUrl>
+#include <QVBoxLayout>
+
+namespace LXQt
+{
+    Q_LOGGING_CATEGORY(XdgDesktopPortalLxqtWallpaper, "xdp-lxqt-wallpaper")
+
+    // pcmanfm-qt uses one picture for all screens, so it has to cover the largest one
+    static QSize largestScreenSize()
+    {
+        QSize size;
+        const auto screens = QGuiApplication::screens();
+        for (const QScreen *screen : screens) {
+            const QSize native = screen->geometry().size() * screen->devicePixelRatio();
+            size = size.expandedTo(native);
+        }
+        return size.isValid() ? size : QSize(1920, 1080);
+    }
+
+    WallpaperPortal::WallpaperPortal(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    uint WallpaperPortal::SetWallpaperURI(const QDBusObjectPath &handle,
+            const QString &app_id,
+            const QString &parent_window,
+            const QString &uri,
+            const QVariantMap &options)
+    {
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "SetWallpaperURI called with parameters:";
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "    handle: " << handle.path();
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "    app_id: " << app_id;
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "    parent_window: " << parent_window;
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "    uri: " << uri;
+        qCDebug(XdgDesktopPortalLxqtWallpaper) << "    options: " << options;
+
+        const QUrl url{uri};
+        if (!url.isLocalFile()) {
+            qCWarning(XdgDesktopPortalLxqtWallpaper) << "Only local wallpapers are supported:" << uri;
+            return 2;
+        }
+        // LXQt has no lock screen picture to set
+        const QString setOn = options.value(QStringLiteral("set-on"), QStringLiteral("both")).toString();
+        if (setOn == QLatin1String("lockscreen")) {
+            qCWarning(XdgDesktopPortalLxqtWallpaper) << "Setting the lock screen picture is not supported";
+            return 2;
+        }
+
+        ParentWindow::prefetch(parent_window);
+
+        const bool showPreview = options.value(QStringLiteral("show-preview")).toBool();
+        const QString source = url.toLocalFile();
+        const QSize screenSize = largestScreenSize();
+        const QSize previewSize = showPreview ? QSize(480, 270) : QSize();
+        const QString directory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/xdg-desktop-portal-lxqt/wallpapers");
+
+        // decoding a 40 megapixel picture takes a while, the GUI thread keeps serving
+        // other requests and the preview dialog meanwhile
+        bool prepared = false;
+        WallpaperImage::Result result;
+        QThread *worker = QThread::create([&] {
+            prepared = WallpaperImage::prepare(source, screenSize, previewSize, directory, result);
+        });
+        // connected before the worker starts; the flag is set in this thread, so a finish
+        // handled while the preview dialog runs is not waited for again
+        bool workerDone = false;
+        QEventLoop workerLoop;
+        QObject::connect(worker, &QThread::finished, &workerLoop, [&] {
+            workerDone = true;
+            workerLoop.quit();
+        });
+        QEventLoop loop;
+
+        bool accepted = true;
+        if (showPreview) {
+            QDialog dialog;
+            dialog.setWindowTitle(tr("Set Wallpaper"));
+            auto layout = new QVBoxLayout{&dialog};
+            auto preview = new QLabel{tr("Loading…"), &dialog};
+            preview->setAlignment(Qt::AlignCenter);
+            preview->setMinimumSize(previewSize);
+            layout->addWidget(preview);
+            auto buttonBox = new QDialogButtonBox{QDialogButtonBox::Cancel, &dialog};
+            QPushButton *setButton = buttonBox->addButton(tr("Set Wallpaper"), QDialogButtonBox::AcceptRole);
+            setButton->setEnabled(false);
+            QObject::connect(buttonBox, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+            QObject::connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+            layout->addWidget(buttonBox);
+
+            QObject::connect(worker, &QThread::finished, &dialog, [&] {
+                if (prepared) {
+                    preview->setPixmap(QPixmap::fromImage(result.preview));
+                    setButton->setEnabled(true);
+                } else {
+                    preview->setText(tr("Cannot load the picture."));
+                }
+            });
+
+            Utils::setParentWindow(&dialog, parent_window);
+            QObject::connect(&dialog, &QDialog::finished, &loop, &QEventLoop::quit);
+            worker->start();
+            dialog.open();
+            Utils::scheduleAutoResponse(&dialog);
+            loop.exec();
+            accepted = dialog.result() == QDialog::Accepted;
+        } else {
+            worker->start();
+        }
+
+        // the worker writes into locals of this frame
+        if (!workerDone) {
+            workerLoop.exec();
+        }
+        worker->wait();
+        delete worker;
+
+        if (!accepted) {
+            return 1;
+        }
+        if (!prepared) {
+            qCWarning(XdgDesktopPortalLxqtWallpaper) << "Cannot prepare" << source << ":" << result.error;
+            return 2;
+        }
+
+        // pcmanfm-qt forwards the request to the running desktop and exits, a stand-in
+        // taking the same arguments can be configured for testing
+        const QString helper = PortalSettings::instance().wallpaperHelper();
+        auto process = new QProcess{this};
+        // the older pictures go only once the desktop took the new one; until then the
+        // desktop config may still point to one of them
+        connect(process, &QProcess::finished, this, [process, helper, directory, fileName = result.fileName](int exitCode, QProcess::ExitStatus exitStatus) {
+            if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+                WallpaperImage::prune(directory, fileName);
+            } else {
+                qCWarning(XdgDesktopPortalLxqtWallpaper) << helper << "failed to set" << fileName << "exit code" << exitCode;
+            }
+            process->deleteLater();
+        });
+        // the picture already covers the screen, "zoom" only centers it
+        process->start(helper, {QStringLiteral("--set-wallpaper"), result.fileName, QStringLiteral("--wallpaper-mode"), QStringLiteral("zoom")});
+        if (!process->waitForStarted()) {
+            qCWarning(XdgDesktopPortalLxqtWallpaper) << "Cannot start" << helper;
+            delete process;
+            return 2;
+        }
+        return 0;
+    }
+}
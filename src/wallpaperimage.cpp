@@ -0,0 +1,113 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#include "wallpaperimage.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+
+namespace LXQt
+{
+    /*static*/ QSize WallpaperImage::decodeSize(const QSize &sourceSize, const QSize &screenSize)
+    {
+        if (!sourceSize.isValid() || !screenSize.isValid()) {
+            return sourceSize;
+        }
+        const QSize cover = sourceSize.scaled(screenSize, Qt::KeepAspectRatioByExpanding);
+        // never scale up, the desktop does that as well as we could
+        return cover.width() < sourceSize.width() ? cover : sourceSize;
+    }
+
+    /*static*/ bool WallpaperImage::prepare(const QString &source, const QSize &screenSize, const QSize &previewSize, const QString &directory, Result &result)
+    {
+        QImageReader reader{source};
+        reader.setAutoTransform(true);
+        QSize sourceSize = reader.size();
+        if (!sourceSize.isValid()) {
+            result.error = reader.errorString();
+            return false;
+        }
+        // size() is before the EXIF orientation is applied
+        if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+            sourceSize.transpose();
+        }
+
+        QSize target = decodeSize(sourceSize, screenSize);
+        if (target != sourceSize) {
+            if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+                target.transpose();
+            }
+            // JPEG decodes at 1/2, 1/4 or 1/8 first, other formats are scaled after decoding
+            reader.setScaledSize(target);
+        }
+
+        QImage image = reader.read();
+        if (image.isNull()) {
+            result.error = reader.errorString();
+            return false;
+        }
+        // the smooth scaler and the encoders have their fast paths for 32-bit pixels
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+
+        if (previewSize.isValid()) {
+            result.preview = image.scaled(previewSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        if (!QDir().mkpath(directory)) {
+            result.error = QStringLiteral("Cannot create %1").arg(directory);
+            return false;
+        }
+        // a new name for every picture, the desktop may cache wallpapers by path
+        const QFileInfo sourceInfo{source};
+        QCryptographicHash hash{QCryptographicHash::Sha1};
+        hash.addData(QFile::encodeName(sourceInfo.absoluteFilePath()));
+        hash.addData(QByteArray::number(sourceInfo.lastModified().toMSecsSinceEpoch()));
+        hash.addData(QByteArray::number(image.width()) + 'x' + QByteArray::number(image.height()));
+        const bool alpha = image.hasAlphaChannel();
+        const QString fileName = QDir{directory}.filePath(QStringLiteral("wallpaper-%1.%2").arg(QString::fromLatin1(hash.result().toHex().left(16)), alpha ? QStringLiteral("png") : QStringLiteral("jpg")));
+
+        QSaveFile file{fileName};
+        if (!file.open(QIODevice::WriteOnly) || !image.save(&file, alpha ? "png" : "jpg", alpha ? -1 : 95) || !file.commit()) {
+            result.error = QStringLiteral("Cannot write %1: %2").arg(fileName, file.errorString());
+            return false;
+        }
+
+        result.fileName = fileName;
+        return true;
+    }
+
+    /*static*/ void WallpaperImage::prune(const QString &directory, const QString &keep)
+    {
+        const QFileInfoList files = QDir{directory}.entryInfoList({QStringLiteral("wallpaper-*")}, QDir::Files);
+        for (const QFileInfo &info : files) {
+            if (info.absoluteFilePath() != QFileInfo{keep}.absoluteFilePath()) {
+                QFile::remove(info.absoluteFilePath());
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/* BEGIN_COMMON_COPYRIGHT_HEADER
+ * (c)LGPL2+
+ *
+ * LXQt - a lightweight, Qt based, desktop toolset
+ * https://lxqt-project.org
+ *
+ * Copyright: 2026~ LXQt team
+ *
+ * This program or library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA
+ *
+ * END_COMMON_COPYRIGHT_HEADER */
+
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+namespace LXQt
+{
+    // Turns a user supplied picture into a screen sized wallpaper file. Meant to run on a
+    // worker thread: large JPEGs are decoded at reduced size (the decoder skips DCT
+    // coefficients instead of producing every source pixel), the rest is resampled with
+    // QImage's smooth scaler on 32-bit pixels, which has SSE/NEON code paths, and the
+    // result is encoded to a file so the desktop never has to touch the original.
+    class WallpaperImage
+    {
+    public:
+        struct Result {
+            QString fileName;
+            QImage preview;
+            QString error;
+        };
+
+        // Scales source so that it covers screenSize and writes it into directory.
+        // previewSize may be empty.
+        static bool prepare(const QString &source, const QSize &screenSize, const QSize &previewSize, const QString &directory, Result &result);
+
+        // removes the wallpapers written before keep, once the desktop uses keep
+        static void prune(const QString &directory, const QString &keep);
+
+        // the size the image at source is decoded to for a screen of screenSize
+        static QSize decodeSize(const QSize &sourceSize, const QSize &screenSize);
+    };
+}